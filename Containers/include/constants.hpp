@@ -5,9 +5,18 @@
 #ifndef ATD_CONSTANTS_HPP
 #define ATD_CONSTANTS_HPP
 
+#include <cstddef>
+
 namespace constants {
     namespace dynamic_array {
         const auto array_capacity(8);
+        // step of the additive growth of the capacity (elements)
+        const auto growth_step(1 << 20);
+        // virtual memory reserved for the mapped array (bytes)
+        const auto mapped_reserve(std::size_t(1) << 36);
+        // signature and version of the file of the persistent array
+        const auto persistent_magic(0x5952524154535250ULL);
+        const auto persistent_version(1U);
     }
     namespace linked_list {
         // 64 - 2 * sizeof(void *)- sizeof(int))
@@ -5,56 +5,205 @@
 #ifndef QUICKSORT_DYNAMIC_ARRAY_HPP
 #define QUICKSORT_DYNAMIC_ARRAY_HPP
 
+#include <algorithm>
+#include <cassert>
+#include <concepts>
+#include <cstdlib>
+#include <cstring>
 #include <iostream>
+#include <iterator>
+#include <limits>
 #include <memory>
+#include <type_traits>
 #include <utility>
 
 #include "constants.hpp"
+#include "malloc_allocator.hpp"
 
 #define LAST_ARRAY_ELEMENT "It is last empty element of the array."
 
+// The trait tells whether an object of type T can be moved to another address
+// by copying its bytes, the old bytes are not destroyed after it.
+// It is true for trivially copyable types and can be specialized for others,
+// e.g. for types which own the memory by a pointer:
+//      template<>
+//      struct is_trivially_relocatable<MyBuffer> : std::true_type {};
+template<typename T>
+struct is_trivially_relocatable : std::is_trivially_copyable<T> {};
+
+template<typename T>
+inline constexpr bool is_trivially_relocatable_v = is_trivially_relocatable<T>::value;
+
+// Policies of the growth of the capacity of Array:
+// the next capacity for the current one.
+// Doubling gives the fewest reallocations,
+// 1.5 times - less unused memory and the reuse of the freed blocks,
+// the additive step - the bounded unused memory for huge arrays.
+// The overflow of the result is detected by the array.
+struct DoublingGrowth {
+    static std::size_t grow(std::size_t capacity) {return capacity * 2;}
+};
+
+struct OneAndHalfGrowth {
+    static std::size_t grow(std::size_t capacity) {return capacity + capacity / 2 + 1;}
+};
+
+template<std::size_t Step = const_array::growth_step>
+struct AdditiveGrowth {
+    static std::size_t grow(std::size_t capacity) {return capacity + Step;}
+};
+
+// The function grows the capacity by the policy Growth
+// until required elements fit (the empty array starts from initial).
+// If the policy overflows or exceeds max,
+// the capacity becomes exactly the required one.
+/// \tparam Growth - the growth policy
+/// \param capacity - the current capacity
+/// \param required - the required capacity
+/// \param max - the largest possible capacity
+/// \param initial - the capacity of the empty array after the growth
+/// \return - the new capacity
+template<typename Growth>
+std::size_t grow_capacity(std::size_t capacity, std::size_t required,
+                          std::size_t max, std::size_t initial = 0) {
+    auto current = capacity;
+    auto new_capacity = (capacity > 0) ? Growth::grow(capacity) : initial;
+    while ((new_capacity > current) && (new_capacity < required)) {
+        current = new_capacity;
+        new_capacity = Growth::grow(current);
+    }
+    if ((new_capacity < required) || (new_capacity > max)) new_capacity = required;
+    return new_capacity;
+}
+
+// Memory for Inline elements inside the object of the array
+// (the elements are constructed in it by the array).
+template<typename T, std::size_t Inline>
+struct InlineStorage {
+    alignas(T) unsigned char bytes[Inline * sizeof(T)];
+
+    T *data() {return reinterpret_cast<T *>(bytes);}
+    const T *data() const {return reinterpret_cast<const T *>(bytes);}
+};
+
+template<typename T>
+struct InlineStorage<T, 0> {
+    T *data() {return nullptr;}
+    const T *data() const {return nullptr;}
+};
+
 // Dynamic array for elements with type T
+// Trivially relocatable elements are moved by realloc (the block can grow
+// in place) and memmove, others - by move constructors.
+// The capacity grows by the policy Growth (DoublingGrowth by default).
+// The memory is taken from Allocator (malloc by default),
+// e.g. std::pmr::polymorphic_allocator with a buffer of the caller:
+//      std::pmr::monotonic_buffer_resource buffer;
+//      Array<int, DoublingGrowth, std::pmr::polymorphic_allocator<int>> a(&buffer);
+// The first Inline elements are kept inside the object without allocation
+// (see SmallArray), the memory is allocated when they do not fit.
 // Example:
 //      Array<int> a;
 //      for (int i = 0; i < 10; ++i) a.insert(i + 1);
-//      for (int i = 0; i < a.size(); ++i) a[i] *= 2;
+//      for (std::size_t i = 0; i < a.size(); ++i) a[i] *= 2;
 //      for (auto it = a.iterator(); it.hasNext(); it.next())
 //          std::cout << it.get() << std::endl;
-template <typename T>
+// The operator [] checks the index, at() and the pointers of data(),
+// begin() and end() (contiguous iterators for the range-for
+// and the standard algorithms) check it only in debug builds:
+//      for (auto &elem : a) elem *= 2;
+//      std::sort(a.begin(), a.end());
+template <typename T, typename Growth = DoublingGrowth,
+          typename Allocator = MallocAllocator<T>, std::size_t Inline = 0>
 class Array final {
+    using AllocatorTraits = std::allocator_traits<Allocator>;
+    // the block of trivially relocatable elements can be resized in place
+    static constexpr bool reallocatable = is_trivially_relocatable_v<T> &&
+            requires(Allocator allocator, T *items, std::size_t count) {
+                {allocator.reallocate(items, count, count)} -> std::same_as<T *>;
+            };
+    // the block can be extended or shrunk in place without moving the elements
+    static constexpr bool recommittable =
+            requires(Allocator allocator, T *items, std::size_t count) {
+                {allocator.recommit(items, count, count)} -> std::same_as<bool>;
+            };
+    static constexpr std::size_t default_capacity =
+            (Inline > 0) ? Inline : const_array::array_capacity;
+    // the difference of the pointers to the elements must fit std::ptrdiff_t
+    static constexpr std::size_t max_capacity =
+            std::numeric_limits<std::ptrdiff_t>::max() / sizeof(T);
+    static constexpr bool nothrow_inline_move =
+            (Inline == 0) || std::is_nothrow_move_constructible_v<T>;
+
     T *items;
-    int _size;
-    int _capacity;
+    std::size_t _size;
+    std::size_t _capacity;
+    [[no_unique_address]] InlineStorage<T, Inline> storage;
+    [[no_unique_address]] Allocator allocator;
 
 // Methods
 public:
-    int size() const;
-    int capacity() const;
+    std::size_t size() const;
+    std::size_t capacity() const;
+    std::size_t max_size() const;
+    void reserve(std::size_t);
+    void shrink_to_fit();
+    Allocator get_allocator() const {return allocator;}
 
     Array();
-    Array(int);
-    Array(const Array<T> &);
+    Array(std::size_t, const Allocator & = Allocator());
+    explicit Array(const Allocator &);
+    Array(const Array &);
+    Array(Array &&) noexcept(nothrow_inline_move);
 
     ~Array();
 
-    const T& operator [](int) const;
-    T& operator [](int);
-    Array<T> &operator =(const Array<T>&);
+    const T& operator [](std::size_t) const;
+    T& operator [](std::size_t);
+    const T& at(std::size_t) const;
+    T& at(std::size_t);
+    T *data() {return items;}
+    const T *data() const {return items;}
+    T *begin() {return items;}
+    T *end() {return items + _size;}
+    const T *begin() const {return items;}
+    const T *end() const {return items + _size;}
+    Array &operator =(const Array&);
+    Array &operator =(Array&&)
+        noexcept((AllocatorTraits::propagate_on_container_move_assignment::value ||
+                  AllocatorTraits::is_always_equal::value) && nothrow_inline_move);
 
     void insert(const T&);
-    void insert(int, const T&);
-    void remove(int);
+    void insert(T&&);
+    void insert(std::size_t, const T&);
+    void insert(std::size_t, T&&);
+    template<typename... Args> void emplace(std::size_t, Args&&...);
+    template<typename... Args> void emplace_back(Args&&...);
+    template<std::forward_iterator InputIt> void insert(std::size_t, InputIt, InputIt);
+    void insert(std::size_t, std::size_t, const T&);
+    void remove(std::size_t);
+    void erase(std::size_t, std::size_t);
+    template<typename Predicate> std::size_t erase_if(Predicate);
 
 private:
-    bool increase(int);
+    bool expand(std::size_t, std::size_t);
+    void collapse(std::size_t, std::size_t, std::size_t);
+    bool increase(std::size_t, std::size_t);
+    bool reallocate(std::size_t, std::size_t, std::size_t);
+    static void relocate(T *, T *, std::size_t);
+    T *resize(std::size_t);
+    bool recommit(std::size_t);
+    T *allocate(std::size_t);
+    void deallocate();
+    bool isInline() const {return (Inline > 0) && (items == storage.data());}
 
 // Auxiliary Class
 public:
     class Iterator {
-        Array<T> *dynamic_array;
-        int _index;
+        Array *dynamic_array;
+        std::size_t _index;
     public:
-        Iterator(Array<T> *dynamic_array, int index = 0)
+        Iterator(Array *dynamic_array, std::size_t index = 0)
         :dynamic_array(dynamic_array), _index(index) {}
 
         Iterator(const Iterator &iterator2)
@@ -75,13 +224,22 @@ public:
         bool hasPrev() const;
         void next();
         void prev();
-        void toIndex(int);
+        void toIndex(std::size_t);
     };
 
     Iterator iterator() {return Iterator(this);}
     const Iterator iterator() const {return Iterator(this);}
 };
 
+// Dynamic array which keeps up to N elements inside the object
+// and allocates the memory only when they do not fit,
+// e.g. for many small arrays:
+//      SmallArray<int, 8> a;
+//      for (int i = 0; i < 8; ++i) a.insert(i + 1); // without allocations
+template<typename T, std::size_t N, typename Growth = DoublingGrowth,
+         typename Allocator = MallocAllocator<T>>
+using SmallArray = Array<T, Growth, Allocator, N>;
+
 /*
  * GETTERS
  */
@@ -90,14 +248,41 @@ public:
 // (the number of elements that actually exist in the array).
 /// \tparam T - type of elements of the array
 /// \return - current_chunk size
-template<typename T>
-int Array<T>::size() const {return _size;}
+template<typename T, typename Growth, typename Allocator, std::size_t Inline>
+std::size_t Array<T, Growth, Allocator, Inline>::size() const {return _size;}
 
 // Returns the capacity (size of the allocated memory).
 /// \tparam T - type of elements of the array
 /// \return - current_chunk capacity
-template<typename T>
-int Array<T>::capacity() const {return _capacity;}
+template<typename T, typename Growth, typename Allocator, std::size_t Inline>
+std::size_t Array<T, Growth, Allocator, Inline>::capacity() const {return _capacity;}
+
+// Returns the largest possible capacity of the array
+// (limited by the allocator and by the difference of the pointers).
+/// \tparam T - type of elements of the array
+/// \return - the maximum number of elements
+template<typename T, typename Growth, typename Allocator, std::size_t Inline>
+std::size_t Array<T, Growth, Allocator, Inline>::max_size() const {
+    return std::min<std::size_t>(max_capacity, AllocatorTraits::max_size(allocator));
+}
+
+// Increases the capacity to the passed value at once
+// (the smaller value and the value more than max_size() are ignored).
+/// \tparam T - type of elements of the array
+/// \param capacity - the required capacity
+template<typename T, typename Growth, typename Allocator, std::size_t Inline>
+void Array<T, Growth, Allocator, Inline>::reserve(std::size_t capacity) {
+    if ((capacity > _capacity) && (capacity <= max_size()))
+        reallocate(capacity, _size, 0);
+}
+
+// Decreases the capacity to the size of the array
+// and gives the unused memory back.
+/// \tparam T - type of elements of the array
+template<typename T, typename Growth, typename Allocator, std::size_t Inline>
+void Array<T, Growth, Allocator, Inline>::shrink_to_fit() {
+    if (std::max(_size, Inline) < _capacity) reallocate(_size, _size, 0);
+}
 
 /*
  * CONSTRUCTORS
@@ -106,39 +291,75 @@ int Array<T>::capacity() const {return _capacity;}
 // The constructor without parameters
 // allocates the memory needed to store a certain number of elements,
 // using the value default _capacity
-// (const_array::array_capacity).
+// (const_array::array_capacity or the inline capacity).
 /// \tparam T  - type of elements of the array
-template<typename T>
-Array<T>::Array()
-:_size(0), _capacity(const_array::array_capacity) {
-    items = (T *)malloc(_capacity * sizeof(T));
-    if (items == nullptr) throw std::runtime_error("Memory allocation error.");
-}
+template<typename T, typename Growth, typename Allocator, std::size_t Inline>
+Array<T, Growth, Allocator, Inline>::Array()
+:Array(default_capacity) {}
 
 // The constructor with the _capacity parameter
 // allocates the memory needed to store a certain number of elements,
-// using an explicitly passed value.
+// using an explicitly passed value
+// (the capacity hint: the array is not reallocated until it is filled,
+// the memory is not allocated if the capacity is not more than Inline;
+// 0 or the capacity more than the maximum, e.g. a converted negative number,
+// gives the default capacity).
 /// \tparam T  - type of elements of the array
 /// \param capacity - size of allocated memory for
-template<typename T>
-Array<T>::Array(int capacity)
-:_size(0), _capacity(capacity > 0 ? capacity : const_array::array_capacity) {
-    items = (T *)malloc(_capacity * sizeof(T));
+/// \param init_allocator - allocator of the memory
+template<typename T, typename Growth, typename Allocator, std::size_t Inline>
+Array<T, Growth, Allocator, Inline>::Array(std::size_t capacity, const Allocator &init_allocator)
+:_size(0),
+_capacity(std::max(((capacity > 0) && (capacity <= max_capacity)) ?
+                   capacity : const_array::array_capacity, Inline)),
+allocator(init_allocator) {
+    items = (_capacity > Inline) ? allocate(_capacity) : storage.data();
     if (items == nullptr) throw std::runtime_error("Memory allocation error.");
 }
 
+// The constructor with the allocator
+// allocates the memory for the default number of elements.
+/// \tparam T  - type of elements of the array
+/// \param init_allocator - allocator of the memory
+template<typename T, typename Growth, typename Allocator, std::size_t Inline>
+Array<T, Growth, Allocator, Inline>::Array(const Allocator &init_allocator)
+:Array(default_capacity, init_allocator) {}
+
 // Copy constructor
 /// \tparam T  - type of elements of the array
 /// \param dynamic_array - object to copy
-template<typename T>
-Array<T>::Array(const Array<T> &dynamic_array)
-:_size(dynamic_array.size()), _capacity(dynamic_array.capacity()) {
-    items = (T *)malloc(dynamic_array.capacity() * sizeof(T));
-    if (items == nullptr) throw std::runtime_error("Memory allocation error.");
-    for (auto i = 0; i < dynamic_array.size(); i++)
+template<typename T, typename Growth, typename Allocator, std::size_t Inline>
+Array<T, Growth, Allocator, Inline>::Array(const Array<T, Growth, Allocator, Inline> &dynamic_array)
+:_size(dynamic_array.size()), _capacity(std::max(dynamic_array.capacity(), Inline)),
+allocator(AllocatorTraits::select_on_container_copy_construction(
+        dynamic_array.allocator)) {
+    items = (_capacity > Inline) ? allocate(_capacity) : storage.data();
+    if ((items == nullptr) && (_capacity > 0))
+        throw std::runtime_error("Memory allocation error.");
+    for (std::size_t i = 0; i < dynamic_array.size(); i++)
         new (&items[i]) T(dynamic_array[i]);
 }
 
+// Move constructor takes the memory of the other array,
+// the other array becomes empty without memory
+// (the inline elements are moved one by one,
+// the other array keeps its inline memory).
+/// \tparam T  - type of elements of the array
+/// \param dynamic_array - object to move
+template<typename T, typename Growth, typename Allocator, std::size_t Inline>
+Array<T, Growth, Allocator, Inline>::Array(Array<T, Growth, Allocator, Inline> &&dynamic_array)
+noexcept(nothrow_inline_move)
+:items(dynamic_array.items), _size(dynamic_array._size),
+_capacity(dynamic_array._capacity), allocator(std::move(dynamic_array.allocator)) {
+    if (dynamic_array.isInline()) {
+        items = storage.data();
+        relocate(dynamic_array.items, items, _size);
+    }
+    dynamic_array.items = dynamic_array.storage.data();
+    dynamic_array._size = 0;
+    dynamic_array._capacity = Inline;
+}
+
 /*
  * DESTRUCTOR
  */
@@ -147,10 +368,10 @@ Array<T>::Array(const Array<T> &dynamic_array)
 // If necessary, when freeing memory, destructors of stored elements are called.
 // unique_ptr - frees the data itself
 /// \tparam T - type of elements of the array
-template<typename T>
-Array<T>::~Array() {
-    for (auto i = 0; i < _size; i++) items[i].~T();
-    free(items);
+template<typename T, typename Growth, typename Allocator, std::size_t Inline>
+Array<T, Growth, Allocator, Inline>::~Array() {
+    for (std::size_t i = 0; i < _size; i++) items[i].~T();
+    deallocate();
 }
 
 /*
@@ -162,9 +383,9 @@ Array<T>::~Array() {
 /// \tparam T - type of elements of the array
 /// \param index - index of the selected array element
 /// \return - unchanged selected element
-template<typename T>
-const T& Array<T>::operator [](int index) const {
-    if ((index < 0) || (index >= _size))
+template<typename T, typename Growth, typename Allocator, std::size_t Inline>
+const T& Array<T, Growth, Allocator, Inline>::operator [](std::size_t index) const {
+    if (index >= _size)
         throw std::invalid_argument("Error index");
     return items[index];
 }
@@ -174,28 +395,98 @@ const T& Array<T>::operator [](int index) const {
 /// \tparam T - type of elements of the array
 /// \param index - index of the selected array element
 /// \return - changed selected element
-template<typename T>
-T& Array<T>::operator [](int index) {
-    if ((index < 0) || (index >= _size))
+template<typename T, typename Growth, typename Allocator, std::size_t Inline>
+T& Array<T, Growth, Allocator, Inline>::operator [](std::size_t index) {
+    if (index >= _size)
         throw std::invalid_argument("Error index");
     return items[index];
 }
 
+// Returns the array element by index for reading without the check
+// of the index in release builds (it is asserted in debug builds).
+/// \tparam T - type of elements of the array
+/// \param index - index of the selected array element
+/// \return - unchanged selected element
+template<typename T, typename Growth, typename Allocator, std::size_t Inline>
+const T& Array<T, Growth, Allocator, Inline>::at(std::size_t index) const {
+    assert(index < _size);
+    return items[index];
+}
+
+// Returns the array element by index for writing without the check
+// of the index in release builds (it is asserted in debug builds).
+/// \tparam T - type of elements of the array
+/// \param index - index of the selected array element
+/// \return - changed selected element
+template<typename T, typename Growth, typename Allocator, std::size_t Inline>
+T& Array<T, Growth, Allocator, Inline>::at(std::size_t index) {
+    assert(index < _size);
+    return items[index];
+}
+
 // Copy assignment operator
+// (the array keeps its allocator).
 /// \tparam T  - type of elements of the array
 /// \param dynamic_array - object to copy
-template<typename T>
-Array<T>& Array<T>::operator =(const Array<T> &dynamic_array) {
+template<typename T, typename Growth, typename Allocator, std::size_t Inline>
+Array<T, Growth, Allocator, Inline>& Array<T, Growth, Allocator, Inline>::operator =(
+        const Array<T, Growth, Allocator, Inline> &dynamic_array) {
     if (&dynamic_array == this) return *this;
-    auto new_items = (T *)malloc(dynamic_array.capacity() * sizeof(T));
-    if (new_items == nullptr) return *this;
-    for (auto i = 0; i < dynamic_array.size(); i++)
-        new (&new_items[i]) T(dynamic_array[i]);
-    for (auto i = 0; i < _size; i++) items[i].~T();
-    free(items);
+    auto new_capacity = std::max(dynamic_array.capacity(), Inline);
+    T *new_items = nullptr;
+    if (new_capacity > Inline) {
+        new_items = allocate(new_capacity);
+        if (new_items == nullptr) return *this;
+        for (std::size_t i = 0; i < dynamic_array.size(); i++)
+            new (&new_items[i]) T(dynamic_array[i]);
+    }
+    for (std::size_t i = 0; i < _size; i++) items[i].~T();
+    deallocate();
+    if (new_items == nullptr) {
+        new_items = storage.data();
+        for (std::size_t i = 0; i < dynamic_array.size(); i++)
+            new (&new_items[i]) T(dynamic_array[i]);
+    }
     items = new_items;
     _size = dynamic_array.size();
-    _capacity = dynamic_array.capacity();
+    _capacity = new_capacity;
+    return *this;
+}
+
+// Move assignment operator destroys the elements of the array
+// and takes the memory of the other array,
+// the other array becomes empty without memory.
+// If the allocators are not equal and the allocator is not propagated
+// (as std::pmr::polymorphic_allocator) or the elements of the other array
+// are inline, the elements are moved one by one.
+/// \tparam T  - type of elements of the array
+/// \param dynamic_array - object to move
+template<typename T, typename Growth, typename Allocator, std::size_t Inline>
+Array<T, Growth, Allocator, Inline>& Array<T, Growth, Allocator, Inline>::operator =(
+        Array<T, Growth, Allocator, Inline> &&dynamic_array)
+        noexcept((AllocatorTraits::propagate_on_container_move_assignment::value ||
+                  AllocatorTraits::is_always_equal::value) && nothrow_inline_move) {
+    if (&dynamic_array == this) return *this;
+    auto is_movable = !dynamic_array.isInline();
+    if constexpr (!AllocatorTraits::propagate_on_container_move_assignment::value &&
+                  !AllocatorTraits::is_always_equal::value)
+        is_movable = is_movable && (allocator == dynamic_array.allocator);
+    if (!is_movable) {
+        for (std::size_t i = 0; i < _size; i++) items[i].~T();
+        _size = 0;
+        if ((dynamic_array._size > _capacity) &&
+            !reallocate(dynamic_array._size, 0, 0)) return *this;
+        relocate(dynamic_array.items, items, dynamic_array._size);
+        _size = std::exchange(dynamic_array._size, 0);
+        return *this;
+    }
+    for (std::size_t i = 0; i < _size; i++) items[i].~T();
+    deallocate();
+    if constexpr (AllocatorTraits::propagate_on_container_move_assignment::value)
+        allocator = std::move(dynamic_array.allocator);
+    items = std::exchange(dynamic_array.items, dynamic_array.storage.data());
+    _size = std::exchange(dynamic_array._size, 0);
+    _capacity = std::exchange(dynamic_array._capacity, Inline);
     return *this;
 }
 
@@ -206,48 +497,271 @@ Array<T>& Array<T>::operator =(const Array<T> &dynamic_array) {
 // Inserts the passed value at the end of the array.
 /// \tparam T - type of elements of the array
 /// \param value - value of the new array element to change
-template<typename T>
-void Array<T>::insert(const T& value) {insert(_size, value);}
+template<typename T, typename Growth, typename Allocator, std::size_t Inline>
+void Array<T, Growth, Allocator, Inline>::insert(const T& value) {emplace(_size, value);}
 
-// Inserts the passed value at the specified position,
+// Moves the passed value to the end of the array.
+/// \tparam T - type of elements of the array
+/// \param value - value of the new array element
+template<typename T, typename Growth, typename Allocator, std::size_t Inline>
+void Array<T, Growth, Allocator, Inline>::insert(T&& value) {emplace(_size, std::move(value));}
+
+// Inserts the passed value at the specified position.
+/// \tparam T - type of elements of the array
+/// \param index - index of the array element to change
+/// \param value - new value of the array element to change
+template<typename T, typename Growth, typename Allocator, std::size_t Inline>
+void Array<T, Growth, Allocator, Inline>::insert(std::size_t index, const T& value) {emplace(index, value);}
+
+// Moves the passed value to the specified position.
+/// \tparam T - type of elements of the array
+/// \param index - index of the array element to change
+/// \param value - new value of the array element
+template<typename T, typename Growth, typename Allocator, std::size_t Inline>
+void Array<T, Growth, Allocator, Inline>::insert(std::size_t index, T&& value) {emplace(index, std::move(value));}
+
+// Constructs the element from the arguments at the specified position,
 // increasing the array size by 1 and,
 // if necessary, shifting existing elements to the right.
 // If there is not enough memory to add an element,
-// it reallocates memory by copying existing elements
-// to a new area using move semantics.
-// Then the old block is released.
-// Memory allocation occurs each time with an increase of 2 times
+// it reallocates memory by relocating existing elements
+// to a new area.
+// Memory allocation occurs each time with an increase by the growth policy
 // relative to the current_chunk size.
+// The element is constructed before the shift,
+// so the arguments can refer to the elements of the array.
 /// \tparam T - type of elements of the array
-/// \param index - index of the array element to change
-/// \param value - new value of the array element to change
-template<typename T>
-void Array<T>::insert(int index, const T& value) {
-    if ((index < 0) || (index > _size)) return;
-    if (_size != _capacity)
-        for (auto i = _size; i > index; i--) items[i] = std::move(items[i - 1]);
-    else if (!increase(index)) return;
-    new (&items[index]) T(value);
+/// \tparam Args - types of the arguments of the constructor of T
+/// \param index - index of the new array element
+/// \param args - the arguments of the constructor of T
+template<typename T, typename Growth, typename Allocator, std::size_t Inline>
+template<typename... Args>
+void Array<T, Growth, Allocator, Inline>::emplace(std::size_t index, Args&&... args) {
+    if (index > _size) return;
+    T value(std::forward<Args>(args)...);
+    if (!expand(index, 1)) return;
+    new (&items[index]) T(std::move(value));
     _size++;
 }
 
-// The function doubles the memory for the array
-// and allocates empty space for a new element at the index.
+// Constructs the element from the arguments at the end of the array.
 /// \tparam T - type of elements of the array
-/// \param index - index of the array element to change
+/// \tparam Args - types of the arguments of the constructor of T
+/// \param args - the arguments of the constructor of T
+template<typename T, typename Growth, typename Allocator, std::size_t Inline>
+template<typename... Args>
+void Array<T, Growth, Allocator, Inline>::emplace_back(Args&&... args) {
+    emplace(_size, std::forward<Args>(args)...);
+}
+
+// Inserts copies of the elements of the range at the specified position
+// by one shift of the existing elements and at most one reallocation.
+// The range must not be a part of the array.
+// If a copy throws, the array keeps its elements and the exception is rethrown.
+/// \tparam T - type of elements of the array
+/// \tparam InputIt - type of iterators of the range
+/// \param index - index of the first new array element
+/// \param first - iterator to the beginning of the range
+/// \param last - iterator after the end of the range
+template<typename T, typename Growth, typename Allocator, std::size_t Inline>
+template<std::forward_iterator InputIt>
+void Array<T, Growth, Allocator, Inline>::insert(std::size_t index, InputIt first, InputIt last) {
+    auto distance = std::distance(first, last);
+    if ((index > _size) || (distance <= 0)) return;
+    auto count = static_cast<std::size_t>(distance);
+    if (!expand(index, count)) return;
+    std::size_t built = 0;
+    try {
+        for (; first != last; ++first, built++) new (&items[index + built]) T(*first);
+    }
+    catch (...) {
+        collapse(index, built, count);
+        throw;
+    }
+    _size += count;
+}
+
+// Inserts count copies of the value at the specified position
+// by one shift of the existing elements and at most one reallocation.
+// If a copy throws, the array keeps its elements and the exception is rethrown.
+/// \tparam T - type of elements of the array
+/// \param index - index of the first new array element
+/// \param count - number of the new elements
+/// \param value - value of the new elements
+template<typename T, typename Growth, typename Allocator, std::size_t Inline>
+void Array<T, Growth, Allocator, Inline>::insert(std::size_t index, std::size_t count, const T& value) {
+    if ((index > _size) || (count == 0)) return;
+    T copy(value);
+    if (!expand(index, count)) return;
+    std::size_t built = 0;
+    try {
+        for (; built < count; built++) new (&items[index + built]) T(copy);
+    }
+    catch (...) {
+        collapse(index, built, count);
+        throw;
+    }
+    _size += count;
+}
+
+// The function frees the place for count elements at the index
+// by shifting the elements to the right or by reallocation.
+/// \tparam T - type of elements of the array
+/// \param index - index of the first new array element
+/// \param count - number of the new elements
 /// \return - successful or not memory allocation
-template<typename T>
-bool Array<T>::increase(int index) {
-    auto new_items = (T *)malloc(_capacity * 2 * sizeof(T));
-    if (new_items == nullptr) return false;
-    for (auto i = 0; i < index; i++) new_items[i] = std::move(items[i]);
-    for (auto i = index; i < _size; i++) new_items[i + 1] = std::move(items[i]);
-    free(items);
-    items = new_items;
-    _capacity *= 2;
+template<typename T, typename Growth, typename Allocator, std::size_t Inline>
+bool Array<T, Growth, Allocator, Inline>::expand(std::size_t index, std::size_t count) {
+    if (count <= _capacity - _size) {
+        relocate(items + index, items + index + count, _size - index);
+        return true;
+    }
+    return increase(index, count);
+}
+
+// The function closes the place for count elements at the index
+// freed by expand: the built new elements are destroyed
+// and the elements after the place are shifted back to the left.
+/// \tparam T - type of elements of the array
+/// \param index - index of the first new array element
+/// \param built - number of the constructed new elements
+/// \param count - number of the new elements
+template<typename T, typename Growth, typename Allocator, std::size_t Inline>
+void Array<T, Growth, Allocator, Inline>::collapse(std::size_t index, std::size_t built,
+                                                   std::size_t count) {
+    for (auto i = index; i < index + built; i++) items[i].~T();
+    relocate(items + index + count, items + index, _size - index);
+}
+
+// The function increases the memory for the array by the growth policy
+// until count new elements fit
+// (the moved-out array gets the default capacity)
+// and allocates empty space for the new elements at the index.
+// If the policy overflows or exceeds max_size(),
+// the capacity becomes exactly the new size.
+/// \tparam T - type of elements of the array
+/// \param index - index of the first new array element
+/// \param count - number of the new elements
+/// \return - successful or not memory allocation
+template<typename T, typename Growth, typename Allocator, std::size_t Inline>
+bool Array<T, Growth, Allocator, Inline>::increase(std::size_t index, std::size_t count) {
+    auto max = max_size();
+    if ((_size > max) || (count > max - _size)) return false;
+    return reallocate(grow_capacity<Growth>(_capacity, _size + count, max,
+                                            default_capacity), index, count);
+}
+
+// The function moves the elements to the memory with the new capacity
+// leaving empty space for count elements at the index.
+// The elements stay in place if the allocator can recommit the block
+// (e.g. MappedAllocator), trivially relocatable elements are kept
+// by realloc of the allocator (it can extend the block or remap its pages
+// without copying), others are moved to the new block.
+// The capacity not more than Inline moves the elements to the inline memory.
+/// \tparam T - type of elements of the array
+/// \param new_capacity - the new capacity (not less than the new size)
+/// \param index - index of the first new array element
+/// \param count - number of the new elements
+/// \return - successful or not memory allocation
+template<typename T, typename Growth, typename Allocator, std::size_t Inline>
+bool Array<T, Growth, Allocator, Inline>::reallocate(std::size_t new_capacity,
+                                                     std::size_t index, std::size_t count) {
+    new_capacity = std::max(new_capacity, Inline);
+    if (new_capacity == 0) deallocate();
+    else if ((new_capacity > Inline) && (items != nullptr) && !isInline() &&
+             recommit(new_capacity))
+        relocate(items + index, items + index + count, _size - index);
+    else if (reallocatable && (new_capacity > Inline) && !isInline()) {
+        auto new_items = resize(new_capacity);
+        if (new_items == nullptr) return false;
+        items = new_items;
+        relocate(items + index, items + index + count, _size - index);
+    }
+    else {
+        auto new_items = (new_capacity > Inline) ? allocate(new_capacity) :
+                         storage.data();
+        if (new_items == nullptr) return false;
+        relocate(items, new_items, index);
+        relocate(items + index, new_items + index + count, _size - index);
+        deallocate();
+        items = new_items;
+    }
+    _capacity = new_capacity;
     return true;
 }
 
+// The function moves the elements to the uninitialized memory
+// (the intervals can overlap), the old elements are destroyed.
+/// \tparam T - type of elements of the array
+/// \param source - pointer to the first moved element
+/// \param destination - pointer to the new place of the first element
+/// \param count - number of elements
+template<typename T, typename Growth, typename Allocator, std::size_t Inline>
+void Array<T, Growth, Allocator, Inline>::relocate(T *source, T *destination, std::size_t count) {
+    if ((count == 0) || (source == destination)) return;
+    if constexpr (is_trivially_relocatable_v<T>)
+        std::memmove(static_cast<void *>(destination), source, count * sizeof(T));
+    else if (destination < source)
+        for (std::size_t i = 0; i < count; i++) {
+            new (&destination[i]) T(std::move(source[i]));
+            source[i].~T();
+        }
+    else
+        for (auto i = count; i > 0; i--) {
+            new (&destination[i - 1]) T(std::move(source[i - 1]));
+            source[i - 1].~T();
+        }
+}
+
+// The function changes the size of the allocated block
+// of the trivially relocatable elements by realloc of the allocator.
+/// \tparam T - type of elements of the array
+/// \param new_capacity - the new capacity
+/// \return - pointer to the block, nullptr if it is not changed
+template<typename T, typename Growth, typename Allocator, std::size_t Inline>
+T *Array<T, Growth, Allocator, Inline>::resize(std::size_t new_capacity) {
+    if constexpr (reallocatable)
+        return allocator.reallocate(items, _capacity, new_capacity);
+    else return nullptr;
+}
+
+// The function changes the capacity of the allocated block in place
+// by recommit of the allocator.
+/// \tparam T - type of elements of the array
+/// \param new_capacity - the new capacity
+/// \return - successful or not (the allocator cannot do it)
+template<typename T, typename Growth, typename Allocator, std::size_t Inline>
+bool Array<T, Growth, Allocator, Inline>::recommit(std::size_t new_capacity) {
+    if constexpr (recommittable)
+        return allocator.recommit(items, _capacity, new_capacity);
+    else return false;
+}
+
+// The function takes the memory for the elements from the allocator.
+/// \tparam T - type of elements of the array
+/// \param capacity - number of elements
+/// \return - pointer to the memory, nullptr if it is not allocated
+template<typename T, typename Growth, typename Allocator, std::size_t Inline>
+T *Array<T, Growth, Allocator, Inline>::allocate(std::size_t capacity) {
+    if (capacity == 0) return nullptr;
+    try {
+        return AllocatorTraits::allocate(allocator, capacity);
+    }
+    catch (const std::bad_alloc &) {
+        return nullptr;
+    }
+}
+
+// The function gives the memory of the elements back to the allocator
+// (the inline memory is kept).
+/// \tparam T - type of elements of the array
+template<typename T, typename Growth, typename Allocator, std::size_t Inline>
+void Array<T, Growth, Allocator, Inline>::deallocate() {
+    if ((items != nullptr) && !isInline())
+        AllocatorTraits::deallocate(allocator, items, _capacity);
+    items = nullptr;
+}
+
 /*
  * REMOVE
  */
@@ -257,49 +771,85 @@ bool Array<T>::increase(int index) {
 // (memory is not freed).
 /// \tparam T - type of elements of the array
 /// \param index - index of the array element to remove
-template<typename T>
-void Array<T>::remove(int index) {
-    if ((index >= _size) || (index < 0)) return;
+template<typename T, typename Growth, typename Allocator, std::size_t Inline>
+void Array<T, Growth, Allocator, Inline>::remove(std::size_t index) {
+    if (index >= _size) return;
     items[index].~T();
-    for (auto i = index + 1; i < _size; i++) items[i - 1] = std::move(items[i]);
+    relocate(items + index + 1, items + index, _size - index - 1);
     _size--;
 }
 
+// Deletes the elements [first; last) of the array
+// by one shift of the remaining elements to the left
+// (memory is not freed).
+/// \tparam T - type of elements of the array
+/// \param first - index of the first removed element
+/// \param last - index after the last removed element
+template<typename T, typename Growth, typename Allocator, std::size_t Inline>
+void Array<T, Growth, Allocator, Inline>::erase(std::size_t first, std::size_t last) {
+    if ((first >= last) || (last > _size)) return;
+    for (auto i = first; i < last; i++) items[i].~T();
+    relocate(items + last, items + first, _size - last);
+    _size -= last - first;
+}
+
+// Deletes the elements satisfying the predicate
+// by one pass moving the kept elements to the left
+// (memory is not freed).
+/// \tparam T - type of elements of the array
+/// \tparam Predicate - type of the predicate
+/// \param pred - the predicate for the removed elements
+/// \return - number of the removed elements
+template<typename T, typename Growth, typename Allocator, std::size_t Inline>
+template<typename Predicate>
+std::size_t Array<T, Growth, Allocator, Inline>::erase_if(Predicate pred) {
+    std::size_t end = 0;
+    for (std::size_t i = 0; i < _size; i++) {
+        if (pred(items[i])) continue;
+        if (end != i) items[end] = std::move(items[i]);
+        end++;
+    }
+    for (auto i = end; i < _size; i++) items[i].~T();
+    auto removed = _size - end;
+    _size = end;
+    return removed;
+}
+
 /*
  * Methods of Iterator
  */
 
-template<typename T>
-const T &Array<T>::Iterator::get() const {return (*dynamic_array)[_index];}
+template<typename T, typename Growth, typename Allocator, std::size_t Inline>
+const T &Array<T, Growth, Allocator, Inline>::Iterator::get() const {return dynamic_array->at(_index);}
 
-template<typename T>
-void Array<T>::Iterator::set(const T& value) {(*dynamic_array)[_index] = value;}
+template<typename T, typename Growth, typename Allocator, std::size_t Inline>
+void Array<T, Growth, Allocator, Inline>::Iterator::set(const T& value) {dynamic_array->at(_index) = value;}
 
-template<typename T>
-void Array<T>::Iterator::insert(const T& value) {
+template<typename T, typename Growth, typename Allocator, std::size_t Inline>
+void Array<T, Growth, Allocator, Inline>::Iterator::insert(const T& value) {
     dynamic_array->insert(_index, value);
 }
 
-template<typename T>
-void Array<T>::Iterator::remove() {dynamic_array->remove(_index);}
+template<typename T, typename Growth, typename Allocator, std::size_t Inline>
+void Array<T, Growth, Allocator, Inline>::Iterator::remove() {dynamic_array->remove(_index);}
 
-template<typename T>
-bool Array<T>::Iterator::hasNext() const {
-    return _index < (dynamic_array->size() - 1);
+template<typename T, typename Growth, typename Allocator, std::size_t Inline>
+bool Array<T, Growth, Allocator, Inline>::Iterator::hasNext() const {
+    return _index + 1 < dynamic_array->size();
 }
 
-template<typename T>
-bool Array<T>::Iterator::hasPrev() const {return _index > 0;}
+template<typename T, typename Growth, typename Allocator, std::size_t Inline>
+bool Array<T, Growth, Allocator, Inline>::Iterator::hasPrev() const {return _index > 0;}
 
-template<typename T>
-void Array<T>::Iterator::next() {if (hasNext()) _index++;}
+template<typename T, typename Growth, typename Allocator, std::size_t Inline>
+void Array<T, Growth, Allocator, Inline>::Iterator::next() {if (hasNext()) _index++;}
 
-template<typename T>
-void Array<T>::Iterator::prev() {if (hasPrev()) _index--;}
+template<typename T, typename Growth, typename Allocator, std::size_t Inline>
+void Array<T, Growth, Allocator, Inline>::Iterator::prev() {if (hasPrev()) _index--;}
 
-template<typename T>
-void Array<T>::Iterator::toIndex(int index) {
-    if ((index >= 0) && (index < dynamic_array->size())) _index = index;
+template<typename T, typename Growth, typename Allocator, std::size_t Inline>
+void Array<T, Growth, Allocator, Inline>::Iterator::toIndex(std::size_t index) {
+    if (index < dynamic_array->size()) _index = index;
 }
 
 #endif //QUICKSORT_DYNAMIC_ARRAY_HPP
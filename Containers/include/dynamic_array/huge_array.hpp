@@ -0,0 +1,24 @@
+/**
+ * Dynamic array in the reserved virtual memory
+ * for the huge number of elements.
+ */
+
+#ifndef QUICKSORT_HUGE_ARRAY_HPP
+#define QUICKSORT_HUGE_ARRAY_HPP
+
+#include "dynamic_array/dynamic_array.hpp"
+#include "mapped_allocator.hpp"
+
+// Dynamic array which commits the pages of the reserved range
+// (const_array::mapped_reserve bytes by default) as it grows:
+// the elements are never moved or copied by the growth,
+// the pointers to them stay valid and the peak memory is not doubled.
+// The capacity is limited by the reserved range.
+// Each array and each copy of it reserves its own whole range.
+// Example:
+//      HugeArray<long> a(1024, MappedAllocator<long>(std::size_t(1) << 40, true));
+//      for (long i = 0; i < (1L << 32); ++i) a.insert(i);
+template<typename T, typename Growth = DoublingGrowth>
+using HugeArray = Array<T, Growth, MappedAllocator<T>>;
+
+#endif //QUICKSORT_HUGE_ARRAY_HPP
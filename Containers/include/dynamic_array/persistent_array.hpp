@@ -0,0 +1,378 @@
+/**
+ * Dynamic array of trivially copyable elements
+ * stored in a memory-mapped file.
+ */
+
+#ifndef QUICKSORT_PERSISTENT_ARRAY_HPP
+#define QUICKSORT_PERSISTENT_ARRAY_HPP
+
+#include <cassert>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <fcntl.h>
+#include <iostream>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <sys/file.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <type_traits>
+#include <unistd.h>
+
+#include "constants.hpp"
+#include "dynamic_array/dynamic_array.hpp"
+
+#define FILE_MAPPING_ERROR "File mapping error."
+#define INCORRECT_ARRAY_FILE "The file does not contain the array of this type."
+#define LOCKED_ARRAY_FILE "The file of the array is opened by another object."
+#define FILE_SYNC_ERROR "File synchronization error."
+
+// The beginning of the file of the persistent array,
+// the elements follow it.
+struct alignas(64) PersistentHeader {
+    std::uint64_t magic;
+    std::uint32_t version;
+    std::uint32_t element_size;
+    std::uint64_t size;
+    std::uint64_t capacity;
+};
+
+// Dynamic array for trivially copyable elements with type T
+// kept in the file mapped to the memory (MAP_SHARED).
+// The file begins with the header (magic, version, size and capacity),
+// so the array is reopened by one mmap without reading the elements:
+// the pages are loaded on demand.
+// The changes get to the file by the system, sync() (msync) is a checkpoint
+// after which they are on the disk, the destructor syncs the array too
+// (and reports the failure to std::cerr, call sync() to check it).
+// The file grows by the policy Growth (the mapping can move),
+// its blocks are allocated before mapping (posix_fallocate),
+// so a full disk fails the growth instead of raising SIGBUS on writing.
+// The file is locked (flock) while the array is open,
+// the second object for the same file is not created.
+// clear() shortens the file to the default capacity.
+// Example:
+//      {
+//          PersistentArray<int> a("table.bin");
+//          for (int i = 0; i < 10; ++i) a.insert(i + 1);
+//          a.sync();
+//      }
+//      PersistentArray<int> b("table.bin"); // b.size() == 10
+template<typename T, typename Growth = DoublingGrowth>
+class PersistentArray final {
+    static_assert(std::is_trivially_copyable_v<T>,
+                  "The elements of the persistent array must be trivially copyable.");
+    static_assert(alignof(T) <= alignof(PersistentHeader),
+                  "The elements must not be aligned stronger than the header.");
+
+    int file;
+    PersistentHeader *header;
+    T *items;
+    // length of the mapping (does not depend on the header in the file)
+    std::size_t mapped_length;
+
+// Methods
+public:
+    explicit PersistentArray(const std::string &,
+                             std::size_t = const_array::array_capacity);
+    PersistentArray(const PersistentArray &) = delete;
+    PersistentArray &operator =(const PersistentArray &) = delete;
+    ~PersistentArray();
+
+    std::size_t size() const {return header->size;}
+    std::size_t capacity() const {
+        return (mapped_length - sizeof(PersistentHeader)) / sizeof(T);
+    }
+    std::size_t max_size() const;
+    void reserve(std::size_t);
+
+    const T& operator [](std::size_t) const;
+    T& operator [](std::size_t);
+    const T& at(std::size_t index) const {assert(index < size()); return items[index];}
+    T& at(std::size_t index) {assert(index < size()); return items[index];}
+    T *data() {return items;}
+    const T *data() const {return items;}
+    T *begin() {return items;}
+    T *end() {return items + size();}
+    const T *begin() const {return items;}
+    const T *end() const {return items + size();}
+
+    void insert(const T&);
+    void insert(std::size_t, const T&);
+    void remove(std::size_t);
+    void clear();
+    bool sync();
+
+private:
+    bool increase(std::size_t);
+    bool remap(std::size_t);
+    bool shrink(std::size_t);
+    [[noreturn]] void fail(const char *, bool = false, const char * = nullptr);
+    static std::size_t length(std::size_t capacity) {
+        return sizeof(PersistentHeader) + capacity * sizeof(T);
+    }
+};
+
+/*
+ * CONSTRUCTORS
+ */
+
+// The constructor opens and locks the file of the array
+// and maps it to the memory.
+// The new (or empty) file gets the header and the place for capacity elements,
+// the existing file is checked by the header and is not read.
+/// \tparam T - type of elements of the array
+/// \param path - path to the file
+/// \param capacity - capacity of the new array (0 - default)
+template<typename T, typename Growth>
+PersistentArray<T, Growth>::PersistentArray(const std::string &path, std::size_t capacity)
+:header(nullptr), items(nullptr), mapped_length(0) {
+    // the file created here is removed on the error
+    auto created = path.c_str();
+    file = open(path.c_str(), O_RDWR | O_CREAT | O_EXCL, 0644);
+    if ((file < 0) && (errno == EEXIST)) {
+        created = nullptr;
+        file = open(path.c_str(), O_RDWR);
+    }
+    if (file < 0) throw std::runtime_error(FILE_MAPPING_ERROR);
+    if (flock(file, LOCK_EX | LOCK_NB) != 0) fail(LOCKED_ARRAY_FILE);
+    struct stat status {};
+    if (fstat(file, &status) != 0) fail(FILE_MAPPING_ERROR);
+    auto file_length = static_cast<std::size_t>(status.st_size);
+    auto is_new = (file_length == 0);
+    if (is_new) {
+        if ((capacity == 0) || (capacity > max_size()))
+            capacity = const_array::array_capacity;
+        file_length = length(capacity);
+        if (posix_fallocate(file, 0, static_cast<off_t>(file_length)) != 0)
+            fail(FILE_MAPPING_ERROR, true, created);
+    }
+    else if (file_length < sizeof(PersistentHeader)) fail(INCORRECT_ARRAY_FILE);
+    auto memory = mmap(nullptr, file_length, PROT_READ | PROT_WRITE,
+                       MAP_SHARED, file, 0);
+    if (memory == MAP_FAILED) fail(FILE_MAPPING_ERROR, is_new, created);
+    header = static_cast<PersistentHeader *>(memory);
+    items = reinterpret_cast<T *>(header + 1);
+    mapped_length = file_length;
+    if (is_new) *header = {const_array::persistent_magic, const_array::persistent_version,
+                           static_cast<std::uint32_t>(sizeof(T)), 0, capacity};
+    else if ((header->magic != const_array::persistent_magic) ||
+             (header->version != const_array::persistent_version) ||
+             (header->element_size != sizeof(T)) ||
+             (header->size > header->capacity) ||
+             (header->capacity > max_size()) ||
+             (length(header->capacity) != file_length)) {
+        munmap(header, mapped_length);
+        fail(INCORRECT_ARRAY_FILE);
+    }
+}
+
+// The function closes the file (releasing the lock) on the error
+// of the constructor and throws the exception.
+/// \tparam T - type of elements of the array
+/// \param message - message of the exception
+/// \param truncate - the empty file is initialized by the constructor
+/// and is emptied back
+/// \param created - path of the file created by the constructor
+/// (it is removed instead of emptying), nullptr - the file existed
+template<typename T, typename Growth>
+void PersistentArray<T, Growth>::fail(const char *message, bool truncate,
+                                      const char *created) {
+    if (truncate && (created != nullptr)) unlink(created);
+    else if (truncate) static_cast<void>(ftruncate(file, 0));
+    close(file);
+    throw std::runtime_error(message);
+}
+
+/*
+ * DESTRUCTOR
+ */
+
+// The destructor writes the changes to the file and closes it,
+// the failure of the writing is reported to std::cerr.
+/// \tparam T - type of elements of the array
+template<typename T, typename Growth>
+PersistentArray<T, Growth>::~PersistentArray() {
+    if (!sync()) std::cerr << FILE_SYNC_ERROR << std::endl;
+    munmap(header, mapped_length);
+    close(file);
+}
+
+/*
+ * GETTERS
+ */
+
+// Returns the largest possible capacity of the array
+// (the length of the file must fit off_t).
+/// \tparam T - type of elements of the array
+/// \return - the maximum number of elements
+template<typename T, typename Growth>
+std::size_t PersistentArray<T, Growth>::max_size() const {
+    return (static_cast<std::size_t>(std::numeric_limits<off_t>::max()) -
+            sizeof(PersistentHeader)) / sizeof(T);
+}
+
+// Increases the capacity (the length of the file) to the passed value at once
+// (the smaller value and the value more than max_size() are ignored).
+/// \tparam T - type of elements of the array
+/// \param capacity - the required capacity
+template<typename T, typename Growth>
+void PersistentArray<T, Growth>::reserve(std::size_t capacity) {
+    if ((capacity > this->capacity()) && (capacity <= max_size())) remap(capacity);
+}
+
+/*
+ * OPERATORS
+ */
+
+// The indexing operator allows you to access an array element by index
+// for reading.
+/// \tparam T - type of elements of the array
+/// \param index - index of the selected array element
+/// \return - unchanged selected element
+template<typename T, typename Growth>
+const T& PersistentArray<T, Growth>::operator [](std::size_t index) const {
+    if (index >= header->size) throw std::invalid_argument("Error index");
+    return items[index];
+}
+
+// The indexing operator allows you to access an array element by index
+// for writing.
+/// \tparam T - type of elements of the array
+/// \param index - index of the selected array element
+/// \return - changed selected element
+template<typename T, typename Growth>
+T& PersistentArray<T, Growth>::operator [](std::size_t index) {
+    if (index >= header->size) throw std::invalid_argument("Error index");
+    return items[index];
+}
+
+/*
+ * INSERT
+ */
+
+// Inserts the passed value at the end of the array.
+/// \tparam T - type of elements of the array
+/// \param value - value of the new array element
+template<typename T, typename Growth>
+void PersistentArray<T, Growth>::insert(const T &value) {insert(header->size, value);}
+
+// Inserts the passed value at the specified position
+// shifting existing elements to the right,
+// the file is extended by the growth policy if it is full.
+/// \tparam T - type of elements of the array
+/// \param index - index of the new array element
+/// \param value - value of the new array element
+template<typename T, typename Growth>
+void PersistentArray<T, Growth>::insert(std::size_t index, const T &value) {
+    if (index > header->size) return;
+    T copy(value);
+    if ((header->size == capacity()) && !increase(header->size + 1)) return;
+    std::memmove(static_cast<void *>(items + index + 1), items + index,
+                 (header->size - index) * sizeof(T));
+    items[index] = copy;
+    header->size++;
+}
+
+// The function increases the capacity by the growth policy
+// until the required number of elements fit
+// (if the policy overflows or exceeds max_size(),
+// the capacity becomes exactly the required one).
+/// \tparam T - type of elements of the array
+/// \param required - the required capacity
+/// \return - successful or not extension of the file
+template<typename T, typename Growth>
+bool PersistentArray<T, Growth>::increase(std::size_t required) {
+    auto max = max_size();
+    if (required > max) return false;
+    return remap(grow_capacity<Growth>(capacity(), required, max));
+}
+
+// The function allocates the blocks of the file for the new capacity
+// and extends its mapping (the mapping can move to another address).
+/// \tparam T - type of elements of the array
+/// \param new_capacity - the new capacity
+/// \return - successful or not extension of the file
+template<typename T, typename Growth>
+bool PersistentArray<T, Growth>::remap(std::size_t new_capacity) {
+    auto old_length = mapped_length, new_length = length(new_capacity);
+    // the length of the header capacity is restored for the check on reopening
+    // (it is longer than the mapping if shrink has not shortened the file)
+    auto restore = [this]() {
+        auto restored = ftruncate(file, static_cast<off_t>(length(header->capacity)));
+        static_cast<void>(restored);
+        return false;
+    };
+    if (posix_fallocate(file, static_cast<off_t>(old_length),
+                        static_cast<off_t>(new_length - old_length)) != 0)
+        return restore();
+    auto memory = mremap(header, old_length, new_length, MREMAP_MAYMOVE);
+    if (memory == MAP_FAILED) return restore();
+    header = static_cast<PersistentHeader *>(memory);
+    items = reinterpret_cast<T *>(header + 1);
+    mapped_length = new_length;
+    header->capacity = new_capacity;
+    return true;
+}
+
+// The function unmaps the end of the file after the new capacity
+// and shortens the file. If the file is not shortened,
+// the header keeps the old capacity matching the length of the file.
+/// \tparam T - type of elements of the array
+/// \param new_capacity - the new capacity (not less than the size)
+/// \return - successful or not shortening of the file
+template<typename T, typename Growth>
+bool PersistentArray<T, Growth>::shrink(std::size_t new_capacity) {
+    auto new_length = length(new_capacity);
+    auto memory = mremap(header, mapped_length, new_length, 0);
+    if (memory == MAP_FAILED) return false;
+    mapped_length = new_length;
+    if (ftruncate(file, static_cast<off_t>(new_length)) != 0) return false;
+    header->capacity = new_capacity;
+    return true;
+}
+
+/*
+ * REMOVE
+ */
+
+// Deletes an element from the specified array position,
+// shifting the remaining elements to the left
+// (the file is not shortened).
+/// \tparam T - type of elements of the array
+/// \param index - index of the array element to remove
+template<typename T, typename Growth>
+void PersistentArray<T, Growth>::remove(std::size_t index) {
+    if (index >= header->size) return;
+    std::memmove(static_cast<void *>(items + index), items + index + 1,
+                 (header->size - index - 1) * sizeof(T));
+    header->size--;
+}
+
+// Deletes all elements and shortens the file
+// to the default capacity (the shorter file is kept).
+/// \tparam T - type of elements of the array
+template<typename T, typename Growth>
+void PersistentArray<T, Growth>::clear() {
+    header->size = 0;
+    std::size_t default_capacity = const_array::array_capacity;
+    if (capacity() > default_capacity) shrink(default_capacity);
+}
+
+/*
+ * CHECKPOINT
+ */
+
+// Writes the changed pages of the elements and the header to the file
+// and waits for the end of the writing.
+/// \tparam T - type of elements of the array
+/// \return - successful or not writing
+template<typename T, typename Growth>
+bool PersistentArray<T, Growth>::sync() {
+    return msync(header, mapped_length, MS_SYNC) == 0;
+}
+
+#endif //QUICKSORT_PERSISTENT_ARRAY_HPP
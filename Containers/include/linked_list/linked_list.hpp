@@ -12,43 +12,40 @@
 
 #include "constants.hpp"
 #include "dynamic_array/dynamic_array.hpp"
+#include "malloc_allocator.hpp"
 
 #define EMPTY_HEAD "Head is empty"
 #define EMPTY_TAIL "Tail is empty"
 #define LAST_LIST_ELEMENT "It is last empty element of the list."
 
 // Double linked list for elements with type T
+// The chunks and their elements are taken from Allocator (malloc by default),
+// e.g. std::pmr::polymorphic_allocator with a pool of the caller:
+//      std::pmr::unsynchronized_pool_resource pool;
+//      List<int, std::pmr::polymorphic_allocator<int>> l(&pool);
 // Example:
 //      List<int> l;
 //      for (int i = 0; i < 10; ++i) l.insertHead(i + 1);
 //      for (auto it = l.iterator(); it.hasNext(); it.next())
 //        std::cout << it.get() << std::endl;
-template <typename T>
+template <typename T, typename Allocator = MallocAllocator<T>>
 class List final {
 // Auxiliary classes
     struct Chunk final {
         T *items;
         int size;
         Chunk *prev, *next;
-
-        Chunk()
-        : size(0), prev(nullptr), next(nullptr) {
-            items = (T *)malloc(const_list::chunk_capacity<T> * sizeof(T));
-            if (items == nullptr)
-                throw std::runtime_error("Memory allocation error.");
-        }
-        ~Chunk() {
-            for (auto i = 0; i < size; i++) items[i].~T();
-            free(items);
-        }
     };
+    using AllocatorTraits = std::allocator_traits<Allocator>;
+    using ChunkAllocator = typename AllocatorTraits::template rebind_alloc<Chunk>;
+    using ChunkAllocatorTraits = std::allocator_traits<ChunkAllocator>;
 public:
     class Iterator {
-        List<T> *linked_list;
+        List *linked_list;
         Chunk *current_chunk;
         int chunk_index;
     public:
-        Iterator(List<T> *linked_list)
+        Iterator(List *linked_list)
         : linked_list(linked_list), current_chunk(linked_list->ptr_head),
         chunk_index(0) {}
 
@@ -82,18 +79,21 @@ public:
 private:
     Chunk *ptr_head, *ptr_tail;
     int _size;
+    [[no_unique_address]] Allocator allocator;
 
 // Methods
 public:
     int size() const;
     const T& head() const;
     const T& tail() const;
+    Allocator get_allocator() const {return allocator;}
 
     List();
-    List(const List<T> &);
+    explicit List(const Allocator &);
+    List(const List &);
     ~List();
 
-    List<T> &operator =(const List<T>&);
+    List &operator =(const List&);
 
     void insertHead(const T&);
     void insertTail(const T&);
@@ -103,27 +103,43 @@ public:
     Iterator iterator() {return Iterator(this);}
     const Iterator iterator() const {return Iterator(this);}
 private:
+    // Takes the chunk and the memory for its elements from the allocator,
+    // the elements of new_chunk are copied into it.
     Chunk *createChunk(Chunk *new_chunk = nullptr, Chunk *prev = nullptr,
                        Chunk *next = nullptr) {
-        auto current_chunk = (Chunk *) malloc(sizeof(Chunk));
-        if (current_chunk == nullptr) return nullptr;
-        if (new_chunk == nullptr) {
-            current_chunk->items =
-                    (T *)malloc(const_list::chunk_capacity<T> * sizeof(T));
-            if (current_chunk->items == nullptr) return nullptr;
-            current_chunk->size = 0;
+        ChunkAllocator chunk_allocator(allocator);
+        Chunk *current_chunk;
+        T *items;
+        try {
+            current_chunk = ChunkAllocatorTraits::allocate(chunk_allocator, 1);
         }
-        else {
-            current_chunk->items = (T *)malloc(new_chunk->size * sizeof(T));
-            if (current_chunk->items == nullptr) return nullptr;
-            current_chunk->size = new_chunk->size;
-            for (auto i = 0; i < current_chunk->size; i++)
+        catch (const std::bad_alloc &) {
+            return nullptr;
+        }
+        try {
+            items = AllocatorTraits::allocate(allocator, const_list::chunk_capacity<T>);
+        }
+        catch (const std::bad_alloc &) {
+            ChunkAllocatorTraits::deallocate(chunk_allocator, current_chunk, 1);
+            return nullptr;
+        }
+        new (current_chunk) Chunk{items, 0, prev, next};
+        if (new_chunk != nullptr) {
+            for (auto i = 0; i < new_chunk->size; i++)
                 new(&current_chunk->items[i]) T(new_chunk->items[i]);
+            current_chunk->size = new_chunk->size;
         }
-        current_chunk->prev = prev;
-        current_chunk->next = next;
         return current_chunk;
     }
+    // Destroys the elements of the chunk
+    // and gives its memory back to the allocator.
+    void destroyChunk(Chunk *current_chunk) {
+        ChunkAllocator chunk_allocator(allocator);
+        for (auto i = 0; i < current_chunk->size; i++) current_chunk->items[i].~T();
+        AllocatorTraits::deallocate(allocator, current_chunk->items,
+                                    const_list::chunk_capacity<T>);
+        ChunkAllocatorTraits::deallocate(chunk_allocator, current_chunk, 1);
+    }
     void removeList(Chunk *head);
 };
 
@@ -134,14 +150,14 @@ private:
 // Returns the current_chunk size
 /// \tparam T - type of elements of the list
 /// \return - current_chunk size
-template<typename T>
-int List<T>::size() const {return _size;}
+template<typename T, typename Allocator>
+int List<T, Allocator>::size() const {return _size;}
 
 // Returns the current_chunk value in the head of the list.
 /// \tparam T - type of elements of the list
 /// \return - current_chunk value in the head of the list
-template<typename T>
-const T& List<T>::head() const {
+template<typename T, typename Allocator>
+const T& List<T, Allocator>::head() const {
     if (_size != 0) return ptr_head->items[0];
     throw std::out_of_range(EMPTY_HEAD);
 }
@@ -149,8 +165,8 @@ const T& List<T>::head() const {
 // Returns the current_chunk value in the tail of the list.
 /// \tparam T - type of elements of the list
 /// \return - current_chunk value in the tail of the list
-template<typename T>
-const T& List<T>::tail() const {
+template<typename T, typename Allocator>
+const T& List<T, Allocator>::tail() const {
     if (_size != 0) return ptr_tail->items[ptr_tail->size - 1];
     throw std::out_of_range(EMPTY_TAIL);
 }
@@ -162,9 +178,17 @@ const T& List<T>::tail() const {
 // The constructor without parameters
 // allocates the memory needed to store 1 chunk.
 /// \tparam T  - type of elements of the list
-template<typename T>
-List<T>::List()
-:_size(0) {
+template<typename T, typename Allocator>
+List<T, Allocator>::List()
+:List(Allocator()) {}
+
+// The constructor with the allocator of the chunks
+// allocates the memory needed to store 1 chunk.
+/// \tparam T  - type of elements of the list
+/// \param init_allocator - allocator of the memory
+template<typename T, typename Allocator>
+List<T, Allocator>::List(const Allocator &init_allocator)
+:_size(0), allocator(init_allocator) {
     ptr_head = createChunk();
     if (ptr_head == nullptr)
         throw std::runtime_error("Memory allocation error.");
@@ -174,9 +198,11 @@ List<T>::List()
 // Copy constructor
 /// \tparam T  - type of elements of the list
 /// \param linked_list - object to copy
-template<typename T>
-List<T>::List(const List<T> &linked_list)
-:_size(linked_list._size){
+template<typename T, typename Allocator>
+List<T, Allocator>::List(const List<T, Allocator> &linked_list)
+:_size(linked_list._size),
+allocator(AllocatorTraits::select_on_container_copy_construction(
+        linked_list.allocator)) {
     ptr_head = createChunk(linked_list.ptr_head);
     if (ptr_head == nullptr)
         throw std::runtime_error("Memory allocation error.");
@@ -203,24 +229,22 @@ List<T>::List(const List<T> &linked_list)
 // If necessary, when freeing memory, destructors of stored elements are called.
 // unique_ptr - frees the data itself
 /// \tparam T - type of elements of the array
-template<typename T>
-List<T>::~List() {//removeList(ptr_head);
+template<typename T, typename Allocator>
+List<T, Allocator>::~List() {//removeList(ptr_head);
     auto current_chunk = ptr_tail;
     while (current_chunk != nullptr) {
         auto next_chunk = current_chunk->prev;
-        current_chunk->~Chunk();
-        free(current_chunk);
+        destroyChunk(current_chunk);
         current_chunk = next_chunk;
     }
 }
 
-template<typename T>
-void List<T>::removeList(Chunk *head) {
+template<typename T, typename Allocator>
+void List<T, Allocator>::removeList(Chunk *head) {
     auto current_chunk = head;
     while (current_chunk != nullptr) {
         auto next_chunk = current_chunk->next;
-        current_chunk->~Chunk();
-        free(current_chunk);
+        destroyChunk(current_chunk);
         current_chunk = next_chunk;
     }
 }
@@ -230,10 +254,11 @@ void List<T>::removeList(Chunk *head) {
  */
 
 // Copy assignment operator
+// (the list keeps its allocator).
 /// \tparam T  - type of elements of the list
 /// \param linked_list - object to copy
-template<typename T>
-List<T>& List<T>::operator =(const List<T> &linked_list) {
+template<typename T, typename Allocator>
+List<T, Allocator>& List<T, Allocator>::operator =(const List<T, Allocator> &linked_list) {
     if (&linked_list == this) return *this;
     auto new_head = createChunk(linked_list.ptr_head);
     if (new_head == nullptr) return *this;
@@ -252,8 +277,7 @@ List<T>& List<T>::operator =(const List<T> &linked_list) {
     auto current_chunk = ptr_head;
     while (current_chunk != nullptr) {
         auto next_chunk = current_chunk->next;
-        current_chunk->~Chunk();
-        free(current_chunk);
+        destroyChunk(current_chunk);
         current_chunk = next_chunk;
     }
     _size = linked_list._size;
@@ -269,8 +293,8 @@ List<T>& List<T>::operator =(const List<T> &linked_list) {
 // Inserts the passed value at the head of the list.
 /// \tparam T - type of elements of the list
 /// \param value - value of the new list head element
-template<typename T>
-void List<T>::insertHead(const T &value) {
+template<typename T, typename Allocator>
+void List<T, Allocator>::insertHead(const T &value) {
     if (ptr_head->size == const_list::chunk_capacity<T>) {
         auto current_chunk = createChunk(nullptr, nullptr, ptr_head);
         if (current_chunk == nullptr) return;
@@ -288,8 +312,8 @@ void List<T>::insertHead(const T &value) {
 // Inserts the passed value at the tail of the list.
 /// \tparam T - type of elements of the list
 /// \param value - value of the new list tail element
-template<typename T>
-void List<T>::insertTail(const T &value) {
+template<typename T, typename Allocator>
+void List<T, Allocator>::insertTail(const T &value) {
     if (ptr_tail->size == const_list::chunk_capacity<T>) {
         auto current_chunk = createChunk(nullptr, ptr_tail);
         if (current_chunk == nullptr) return;
@@ -307,8 +331,8 @@ void List<T>::insertTail(const T &value) {
 
 // Remove value at the head of the list.
 /// \tparam T - type of elements of the list
-template<typename T>
-void List<T>::removeHead() {
+template<typename T, typename Allocator>
+void List<T, Allocator>::removeHead() {
     if (ptr_head->size == 0) return;
     ptr_head->items[0].~T();
     for (auto i = 0; i < (ptr_head->size - 1); i++)
@@ -318,15 +342,15 @@ void List<T>::removeHead() {
     if ((ptr_head->size == 0) && (_size > 0)) {
         auto new_head = ptr_head->next;
         new_head->prev = nullptr;
-        free(ptr_head);
+        destroyChunk(ptr_head);
         ptr_head = new_head;
     }
 }
 
 // Remove value at the tail of the list.
 /// \tparam T - type of elements of the list
-template<typename T>
-void List<T>::removeTail() {
+template<typename T, typename Allocator>
+void List<T, Allocator>::removeTail() {
     if (ptr_tail->size == 0) return;
     ptr_tail->items[ptr_tail->size - 1].~T();
     ptr_tail->size--;
@@ -334,7 +358,7 @@ void List<T>::removeTail() {
     if ((ptr_tail->size == 0) && (_size > 0)) {
         auto new_tail = ptr_tail->prev;
         new_tail->next = nullptr;
-        free(ptr_tail);
+        destroyChunk(ptr_tail);
         ptr_tail = new_tail;
     }
 }
@@ -343,18 +367,18 @@ void List<T>::removeTail() {
  * Methods of Iterator
  */
 
-template<typename T>
-const T &List<T>::Iterator::get() const {
+template<typename T, typename Allocator>
+const T &List<T, Allocator>::Iterator::get() const {
     return current_chunk->items[chunk_index];
 }
 
-template<typename T>
-void List<T>::Iterator::set(const T& value) {
+template<typename T, typename Allocator>
+void List<T, Allocator>::Iterator::set(const T& value) {
     new (&current_chunk->items[chunk_index]) T(value);
 }
 
-template<typename T>
-void List<T>::Iterator::insert(const T& value) {
+template<typename T, typename Allocator>
+void List<T, Allocator>::Iterator::insert(const T& value) {
     if (current_chunk->size == const_list::chunk_capacity<T>) addNewChunk();
     else
         for (auto i = current_chunk->size; i > chunk_index; i--)
@@ -364,8 +388,8 @@ void List<T>::Iterator::insert(const T& value) {
     linked_list->_size++;
 }
 
-template<typename T>
-void List<T>::Iterator::addNewChunk() {
+template<typename T, typename Allocator>
+void List<T, Allocator>::Iterator::addNewChunk() {
     auto new_chunk = linked_list->createChunk(
             nullptr, current_chunk, current_chunk->next);
     if (new_chunk == nullptr) return;
@@ -378,8 +402,8 @@ void List<T>::Iterator::addNewChunk() {
     current_chunk->size = chunk_index;
 }
 
-template<typename T>
-void List<T>::Iterator::remove()  {
+template<typename T, typename Allocator>
+void List<T, Allocator>::Iterator::remove()  {
     if ((current_chunk->size == 0) || (chunk_index == current_chunk->size)) return;
     current_chunk->items[chunk_index].~T();
     for (auto i = chunk_index; i < (current_chunk->size - 1); i++)
@@ -389,8 +413,8 @@ void List<T>::Iterator::remove()  {
     if ((current_chunk->size == 0) && (linked_list->_size > 0)) removeChunk();
 }
 
-template<typename T>
-void List<T>::Iterator::removeChunk() {
+template<typename T, typename Allocator>
+void List<T, Allocator>::Iterator::removeChunk() {
     if (current_chunk->next != nullptr)
         (current_chunk->next)->prev = current_chunk->prev;
     else linked_list->ptr_tail = current_chunk->prev;
@@ -407,22 +431,22 @@ void List<T>::Iterator::removeChunk() {
         new_current_chunk = current_chunk->prev;
         chunk_index = new_current_chunk->size - 1;
     }
-    free(current_chunk);
+    linked_list->destroyChunk(current_chunk);
     current_chunk = new_current_chunk;
 }
 
-template<typename T>
-bool List<T>::Iterator::hasNext() const {
+template<typename T, typename Allocator>
+bool List<T, Allocator>::Iterator::hasNext() const {
     return (current_chunk->next != nullptr) || (chunk_index < (current_chunk->size - 1));
 }
 
-template<typename T>
-bool List<T>::Iterator::hasPrev() const {
+template<typename T, typename Allocator>
+bool List<T, Allocator>::Iterator::hasPrev() const {
     return (current_chunk->prev != nullptr) || (chunk_index > 0);
 }
 
-template<typename T>
-void List<T>::Iterator::next() {
+template<typename T, typename Allocator>
+void List<T, Allocator>::Iterator::next() {
     if (!hasNext()) return;
     if (chunk_index < (current_chunk->size - 1)) chunk_index++;
     else {
@@ -431,8 +455,8 @@ void List<T>::Iterator::next() {
     }
 }
 
-template<typename T>
-void List<T>::Iterator::prev() {
+template<typename T, typename Allocator>
+void List<T, Allocator>::Iterator::prev() {
     if (!hasPrev()) return;
     if (chunk_index > 0) chunk_index--;
     else {
@@ -0,0 +1,49 @@
+/**
+ * Allocator of the containers by default (malloc and free).
+ */
+
+#ifndef ATD_MALLOC_ALLOCATOR_HPP
+#define ATD_MALLOC_ALLOCATOR_HPP
+
+#include <cstddef>
+#include <cstdlib>
+#include <limits>
+#include <new>
+
+// Allocator with malloc and free,
+// it can also change the size of the block by realloc,
+// so the containers can grow trivially relocatable elements in place.
+// Other allocators (e.g. std::pmr::polymorphic_allocator) are used
+// by the containers through std::allocator_traits.
+template<typename T>
+struct MallocAllocator {
+    using value_type = T;
+
+    MallocAllocator() = default;
+    template<typename U>
+    MallocAllocator(const MallocAllocator<U> &) noexcept {}
+
+    T *allocate(std::size_t count) {
+        if (count > max_size()) throw std::bad_array_new_length();
+        auto memory = static_cast<T *>(std::malloc(count * sizeof(T)));
+        if ((memory == nullptr) && (count > 0)) throw std::bad_alloc();
+        return memory;
+    }
+    void deallocate(T *memory, std::size_t) noexcept {std::free(memory);}
+    std::size_t max_size() const noexcept {
+        return std::numeric_limits<std::size_t>::max() / sizeof(T);
+    }
+
+    // Changes the size of the block keeping its bytes,
+    // returns nullptr if it fails (the old block is not changed).
+    T *reallocate(T *memory, std::size_t, std::size_t count) noexcept {
+        if (count > max_size()) return nullptr;
+        return static_cast<T *>(
+                std::realloc(static_cast<void *>(memory), count * sizeof(T)));
+    }
+
+    template<typename U>
+    bool operator ==(const MallocAllocator<U> &) const noexcept {return true;}
+};
+
+#endif //ATD_MALLOC_ALLOCATOR_HPP
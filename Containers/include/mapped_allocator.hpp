@@ -0,0 +1,113 @@
+/**
+ * Allocator of the huge containers which reserves the virtual memory
+ * and commits its pages as the container grows (mmap).
+ */
+
+#ifndef ATD_MAPPED_ALLOCATOR_HPP
+#define ATD_MAPPED_ALLOCATOR_HPP
+
+#include <cstddef>
+#include <new>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include "constants.hpp"
+
+// Allocator which reserves the range of reserve bytes of the virtual memory
+// without access (PROT_NONE) for each block
+// and gives the access only to the pages of the allocated elements.
+// The block is extended and shrunk in place by recommit,
+// so the elements are not moved and the pointers to them stay valid,
+// the growth costs only the new pages (they are backed by the physical memory
+// when they are touched). The transparent huge pages can be asked for the range.
+// Every block takes the whole reserved range of the address space
+// (64 GiB by default), including the block of every copy of a container:
+// about two thousand blocks fill the 47-bit user address space,
+// so many small containers should use a smaller reserve or another allocator.
+// Example:
+//      MappedAllocator<int> allocator(std::size_t(1) << 34, true);
+//      auto items = allocator.allocate(1024);
+//      allocator.recommit(items, 1024, 1 << 20);
+//      allocator.deallocate(items, 1 << 20);
+template<typename T>
+class MappedAllocator {
+    template<typename U> friend class MappedAllocator;
+
+    // size of the reserved range of each block (bytes)
+    std::size_t reserve;
+    // madvise(MADV_HUGEPAGE) for the reserved range
+    bool huge_pages;
+public:
+    using value_type = T;
+
+    explicit MappedAllocator(std::size_t init_reserve = const_array::mapped_reserve,
+                             bool init_huge_pages = false) noexcept
+    : reserve(roundToPages(init_reserve)), huge_pages(init_huge_pages) {}
+    template<typename U>
+    MappedAllocator(const MappedAllocator<U> &allocator) noexcept
+    : reserve(allocator.reserve), huge_pages(allocator.huge_pages) {}
+
+    T *allocate(std::size_t);
+    void deallocate(T *memory, std::size_t) noexcept {munmap(memory, reserve);}
+    bool recommit(T *, std::size_t, std::size_t) noexcept;
+    std::size_t max_size() const noexcept {return reserve / sizeof(T);}
+
+    template<typename U>
+    bool operator ==(const MappedAllocator<U> &allocator) const noexcept {
+        return reserve == allocator.reserve;
+    }
+private:
+    static std::size_t roundToPages(std::size_t bytes) noexcept {
+        static const auto page = static_cast<std::size_t>(sysconf(_SC_PAGESIZE));
+        return (bytes + page - 1) / page * page;
+    }
+};
+
+// Reserves the range and gives the access to the pages of count elements.
+/// \tparam T - type of elements
+/// \param count - number of elements
+/// \return - pointer to the beginning of the range
+template<typename T>
+T *MappedAllocator<T>::allocate(std::size_t count) {
+    if (count > max_size()) throw std::bad_array_new_length();
+    auto memory = mmap(nullptr, reserve, PROT_NONE,
+                       MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (memory == MAP_FAILED) throw std::bad_alloc();
+#ifdef MADV_HUGEPAGE
+    if (huge_pages) madvise(memory, reserve, MADV_HUGEPAGE);
+#endif
+    auto bytes = roundToPages(count * sizeof(T));
+    if ((bytes > 0) && (mprotect(memory, bytes, PROT_READ | PROT_WRITE) != 0)) {
+        munmap(memory, reserve);
+        throw std::bad_alloc();
+    }
+    return static_cast<T *>(memory);
+}
+
+// Changes the number of the accessible elements of the block in place:
+// the new pages are committed, the pages after the new end
+// are given back to the system and lose the access.
+/// \tparam T - type of elements
+/// \param memory - pointer to the beginning of the block
+/// \param old_count - current number of elements
+/// \param new_count - new number of elements
+/// \return - successful or not (the range is too small
+/// or the system cannot change the access of the pages)
+template<typename T>
+bool MappedAllocator<T>::recommit(T *memory, std::size_t old_count,
+                                  std::size_t new_count) noexcept {
+    if (new_count > max_size()) return false;
+    auto begin = reinterpret_cast<char *>(memory);
+    auto old_bytes = roundToPages(old_count * sizeof(T)),
+            new_bytes = roundToPages(new_count * sizeof(T));
+    if (new_bytes > old_bytes)
+        return mprotect(begin + old_bytes, new_bytes - old_bytes,
+                        PROT_READ | PROT_WRITE) == 0;
+    if (new_bytes < old_bytes) {
+        madvise(begin + new_bytes, old_bytes - new_bytes, MADV_DONTNEED);
+        return mprotect(begin + new_bytes, old_bytes - new_bytes, PROT_NONE) == 0;
+    }
+    return true;
+}
+
+#endif //ATD_MAPPED_ALLOCATOR_HPP
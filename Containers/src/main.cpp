@@ -8,7 +8,7 @@ int main() {
     Array<int> a;
     for (int i = 0; i < 10; ++i) a.insert(i + 1);
     a.size();
-    for (int i = 0; i < a.size(); ++i) a[i] *= 2;
+    for (std::size_t i = 0; i < a.size(); ++i) a[i] *= 2;
     auto it = a.iterator();
     for (; it.hasNext(); it.next())
         std::cout << it.get() << " ";
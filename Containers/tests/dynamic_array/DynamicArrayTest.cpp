@@ -11,9 +11,28 @@
  */
 
 #include "gtest/gtest.h"
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <memory_resource>
+#include <numeric>
+#include <stdexcept>
+
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <unistd.h>
 
 #include "constants.hpp"
+
 #include "dynamic_array/dynamic_array.hpp"
+#include "dynamic_array/huge_array.hpp"
+#include "dynamic_array/persistent_array.hpp"
 
 #define TEST_CONSTRUCTOR_MESSAGE "RunTestConstructor\n"
 #define TEST_DESTRUCTOR_MESSAGE "RunTestDestructor\n"
@@ -31,6 +50,40 @@ public:
     ~TestClass() {std::cout << TEST_DESTRUCTOR_MESSAGE;}
 };
 
+// Test class owning the memory which can be relocated by bytes.
+class RelocatableClass {
+public:
+    std::unique_ptr<int> data;
+    explicit RelocatableClass(int data = 1)
+    :data(std::make_unique<int>(data)) {}
+    RelocatableClass(const RelocatableClass &object)
+    :data(std::make_unique<int>(*object.data)) {}
+};
+
+template<>
+struct is_trivially_relocatable<RelocatableClass> : std::true_type {};
+
+// Test class whose copy constructor throws after copies_left copies
+// (-1 - never).
+class ThrowingClass {
+public:
+    static inline int copies_left = -1;
+    std::string data;
+    explicit ThrowingClass(std::string data = "")
+    :data(std::move(data)) {}
+    ThrowingClass(const ThrowingClass &object)
+    :data(object.data) {
+        if (copies_left-- == 0) throw std::runtime_error("copy");
+    }
+    ThrowingClass(ThrowingClass &&object) noexcept = default;
+};
+
+// Path of the temporary file unique for the process.
+std::filesystem::path getTemporaryPath(const std::string& name) {
+    return std::filesystem::temp_directory_path() /
+           (name + "_" + std::to_string(getpid()) + ".bin");
+}
+
 std::string getTestSomeMessage(const std::string& message, int times) {
     std::string result;
     for (auto i = 0; i < times; i++) result.append(message);
@@ -141,9 +194,11 @@ TEST(DynamicArrayTest, SimpleType_CopyConstructor) {
 
         EXPECT_EQ(array1.size(), array2.size());
         EXPECT_EQ(array1.capacity(), array2.capacity());
-        if (array1.size() == array2.size())
-            for (auto i = 0; i < array1.size(); i++)
+        if (array1.size() == array2.size()) {
+            for (std::size_t i = 0; i < array1.size(); i++) {
                 EXPECT_EQ(array1[i], array2[i]);
+            }
+        }
     }
     EXPECT_EQ(array1[0], 1);
     EXPECT_EQ(array1[1], 2);
@@ -166,9 +221,11 @@ TEST(DynamicArrayTest, ComplexType_CopyConstructor) {
             times = array2.size();
             EXPECT_EQ(array1.size(), array2.size());
             EXPECT_EQ(array1.capacity(), array2.capacity());
-            if (array1.size() == array2.size())
-                for (auto i = 0; i < array1.size(); i++)
+            if (array1.size() == array2.size()) {
+                for (std::size_t i = 0; i < array1.size(); i++) {
                     EXPECT_EQ(array1[i].data, array2[i].data);
+                }
+            }
             ::testing::internal::CaptureStdout();
         }
         std::string output_message = ::testing::internal::GetCapturedStdout();
@@ -248,9 +305,11 @@ TEST(DynamicArrayTest, SimpleType_OperatorAssignment) {
 
     EXPECT_EQ(array1.size(), array2.size());
     EXPECT_EQ(array1.capacity(), array2.capacity());
-    if (array1.size() == array2.size())
-        for (auto i = 0; i < array1.size(); i++)
+    if (array1.size() == array2.size()) {
+        for (std::size_t i = 0; i < array1.size(); i++) {
             EXPECT_EQ(array1[i], array2[i]);
+        }
+    }
 }
 
 // The test checks whether arrays of complex type
@@ -268,9 +327,11 @@ TEST(DynamicArrayTest, ComplexType_OperatorAssignment) {
             times = array1.size();
             EXPECT_EQ(array1.size(), array2.size());
             EXPECT_EQ(array1.capacity(), array2.capacity());
-            if (array1.size() == array2.size())
-                for (auto i = 0; i < array1.size(); i++)
+            if (array1.size() == array2.size()) {
+                for (std::size_t i = 0; i < array1.size(); i++) {
                     EXPECT_EQ(array1[i].data, array2[i].data);
+                }
+            }
         ::testing::internal::CaptureStdout();
         }
         std::string output_message = ::testing::internal::GetCapturedStdout();
@@ -557,6 +618,599 @@ TEST(DynamicArrayTest, ComplexType_Remove) {
               getTestSomeMessage(TEST_DESTRUCTOR_MESSAGE, times));
 }
 
+// The test checks that the elements of trivially copyable type
+// keep their values after many reallocations: insert(const T&)
+TEST(DynamicArrayTest, SimpleType_Relocation) {
+    Array<long> array(1);
+    for (auto i = 0; i < 100000; i++) array.insert(i);
+    array.insert(0, -1);
+
+    EXPECT_EQ(array.size(), 100001);
+    EXPECT_EQ(array.capacity(), 131072);
+    EXPECT_EQ(array[0], -1);
+    for (auto i = 0; i < 100000; i++) EXPECT_EQ(array[i + 1], i);
+}
+
+// The test checks that the elements of type with the specialized trait
+// are relocated by bytes and the elements of type without it
+// are moved by constructors: insert(int, const T&)
+TEST(DynamicArrayTest, RelocatableType_Relocation) {
+    Array<RelocatableClass> relocatable(1);
+    Array<std::string> strings(1);
+    for (auto i = 0; i < 20; i++) {
+        relocatable.insert(0, RelocatableClass(i));
+        strings.insert(i / 2, std::to_string(i));
+    }
+    relocatable.remove(5);
+    strings.remove(5);
+
+    EXPECT_TRUE(is_trivially_relocatable_v<RelocatableClass>);
+    EXPECT_FALSE(is_trivially_relocatable_v<std::string>);
+    EXPECT_EQ(relocatable.size(), 19);
+    EXPECT_EQ(*relocatable[0].data, 19);
+    EXPECT_EQ(*relocatable[5].data, 13);
+    EXPECT_EQ(*relocatable[18].data, 0);
+    EXPECT_EQ(strings.size(), 19);
+    EXPECT_EQ(strings[0], "1");
+    EXPECT_EQ(strings[5], "13");
+    EXPECT_EQ(strings[18], "0");
+}
+
+// The test checks that the move constructor takes the elements
+// without copying and the moved-out array can be used again: Array(Array&&)
+TEST(DynamicArrayTest, ComplexType_MoveConstructor) {
+    TestClass test1(1), test2(2);
+    Array<TestClass> array1;
+    array1.insert(test1);
+    array1.insert(test2);
+    {
+        ::testing::internal::CaptureStdout();
+
+        Array<TestClass> array2(std::move(array1));
+
+        std::string output_message = ::testing::internal::GetCapturedStdout();
+        EXPECT_EQ(output_message, "");
+        EXPECT_EQ(array2.size(), 2);
+        EXPECT_EQ(array2[1].data, 2);
+        EXPECT_EQ(array1.size(), 0);
+        EXPECT_EQ(array1.capacity(), 0);
+        ::testing::internal::CaptureStdout();
+    }
+    std::string output_message = ::testing::internal::GetCapturedStdout();
+    EXPECT_EQ(output_message, getTestSomeMessage(TEST_DESTRUCTOR_MESSAGE, 2));
+    array1.insert(test1);
+    EXPECT_EQ(array1.size(), 1);
+    EXPECT_EQ(array1.capacity(), const_array::array_capacity);
+    EXPECT_TRUE(std::is_nothrow_move_constructible_v<Array<TestClass>>);
+}
+
+// The test checks that the move assignment destroys the old elements
+// and takes the elements of the other array: operator=(Array&&)
+TEST(DynamicArrayTest, StringType_MoveAssignment) {
+    Array<std::string> array1, array2;
+    array1.insert(std::string("a"));
+    array1.insert(std::string("b"));
+    array2.insert(std::string("c"));
+
+    array2 = std::move(array1);
+
+    EXPECT_EQ(array2.size(), 2);
+    EXPECT_EQ(array2[0], "a");
+    EXPECT_EQ(array2[1], "b");
+    EXPECT_EQ(array1.size(), 0);
+    EXPECT_TRUE(std::is_nothrow_move_assignable_v<Array<std::string>>);
+}
+
+// The test checks that the values are moved into the array
+// and the elements are constructed from the arguments in place:
+// insert(T&&), insert(int, T&&), emplace(int, Args&&...), emplace_back(Args&&...)
+TEST(DynamicArrayTest, StringType_InsertMoveEmplace) {
+    Array<std::string> array(1);
+    std::string value(100, 'a');
+    auto data = value.data();
+
+    array.insert(std::move(value));
+    array.insert(0, std::string("b"));
+    array.emplace(1, 3, 'c');
+    array.emplace_back("d");
+    array.emplace(10, "out of range");
+    array.emplace_back(array[1]);
+
+    EXPECT_EQ(array.size(), 5);
+    EXPECT_EQ(array[0], "b");
+    EXPECT_EQ(array[1], "ccc");
+    EXPECT_EQ(array[2].data(), data);
+    EXPECT_EQ(array[3], "d");
+    EXPECT_EQ(array[4], "ccc");
+}
+
+// The test checks that the range and the copies of the value
+// are inserted by one reallocation: insert(int, InputIt, InputIt),
+// insert(int, int, const T&)
+TEST(DynamicArrayTest, StringType_BulkInsert) {
+    Array<std::string> array(2);
+    array.insert(std::string("a"));
+    array.insert(std::string("e"));
+    std::vector<std::string> range {"b", "c", "d"};
+
+    array.insert(1, range.begin(), range.end());
+
+    EXPECT_EQ(array.size(), 5);
+    EXPECT_EQ(array.capacity(), 8);
+
+    array.insert(5, 3, std::string("f"));
+    array.insert(0, 0, std::string("x"));
+    array.insert(9, range.begin(), range.end());//Out of range
+
+    EXPECT_EQ(array.size(), 8);
+    EXPECT_EQ(array.capacity(), 8);
+    std::string result;
+    for (std::size_t i = 0; i < array.size(); i++) result += array[i];
+    EXPECT_EQ(result, "abcdefff");
+}
+
+// The test checks that the array keeps its elements
+// if a copy of the inserted elements throws:
+// insert(int, InputIt, InputIt), insert(int, int, const T&)
+TEST(DynamicArrayTest, ThrowingType_BulkInsertException) {
+    ThrowingClass::copies_left = -1;
+    Array<ThrowingClass> array(2);
+    array.insert(ThrowingClass("a"));
+    array.insert(ThrowingClass("b"));
+    array.insert(ThrowingClass("c"));
+    std::vector<ThrowingClass> range(4, ThrowingClass("x"));
+
+    ThrowingClass::copies_left = 2;
+    EXPECT_THROW(array.insert(1, range.begin(), range.end()), std::runtime_error);
+    ThrowingClass::copies_left = 3;
+    EXPECT_THROW(array.insert(2, 10, ThrowingClass("y")), std::runtime_error);
+
+    EXPECT_EQ(array.size(), 3);
+    std::string result;
+    for (auto &element : array) result += element.data;
+    EXPECT_EQ(result, "abc");
+    ThrowingClass::copies_left = -1;
+    array.insert(1, range.begin(), range.end());
+
+    EXPECT_EQ(array.size(), 7);
+}
+
+// The test checks that the intervals are deleted
+// and the destructors are called once for each element
+// at the end of the array: erase(int, int)
+TEST(DynamicArrayTest, ComplexType_Erase) {
+    TestClass test(1);
+    Array<TestClass> array;
+    for (auto i = 0; i < 6; i++) array.emplace_back(i);
+
+    ::testing::internal::CaptureStdout();
+    array.erase(3, 6);
+    array.erase(2, 1);//Incorrect interval
+    std::string output_message = ::testing::internal::GetCapturedStdout();
+    array.erase(0, 2);
+
+    EXPECT_EQ(output_message, getTestSomeMessage(TEST_DESTRUCTOR_MESSAGE, 3));
+    EXPECT_EQ(array.size(), 1);
+    EXPECT_EQ(array[0].data, 2);
+}
+
+// The test checks that the elements satisfying the predicate are deleted
+// and the order of the kept elements is not changed: erase_if(Predicate)
+TEST(DynamicArrayTest, StringType_EraseIf) {
+    Array<std::string> array;
+    for (auto i = 0; i < 10; i++) array.insert(std::to_string(i));
+
+    auto removed = array.erase_if([](const std::string &value) {
+        return (value[0] - '0') % 3 == 0;
+    });
+
+    EXPECT_EQ(removed, 4);
+    EXPECT_EQ(array.size(), 6);
+    std::string result;
+    for (std::size_t i = 0; i < array.size(); i++) result += array[i];
+    EXPECT_EQ(result, "124578");
+}
+
+// The test checks that reserve increases the capacity at once
+// and shrink_to_fit gives the unused memory back: reserve(int), shrink_to_fit()
+TEST(DynamicArrayTest, StringType_ReserveShrinkToFit) {
+    Array<std::string> array(2);
+    array.insert(std::string("a"));
+    array.insert(std::string("b"));
+
+    array.reserve(100);
+    array.reserve(10);
+
+    EXPECT_EQ(array.capacity(), 100);
+    for (auto i = 0; i < 98; i++) array.insert(std::to_string(i));
+    EXPECT_EQ(array.capacity(), 100);
+
+    array.erase(3, 100);
+    array.shrink_to_fit();
+
+    EXPECT_EQ(array.size(), 3);
+    EXPECT_EQ(array.capacity(), 3);
+    EXPECT_EQ(array[0], "a");
+    EXPECT_EQ(array[2], "0");
+
+    array.erase(0, 3);
+    array.shrink_to_fit();
+    array.insert(std::string("c"));
+
+    EXPECT_EQ(array.capacity(), const_array::array_capacity);
+    EXPECT_EQ(array[0], "c");
+}
+
+// The test checks the capacities given by the growth policies:
+// Array<T, Growth>
+TEST(DynamicArrayTest, SimpleType_GrowthPolicies) {
+    Array<int, OneAndHalfGrowth> one_and_half(4);
+    Array<int, AdditiveGrowth<3>> additive(4);
+    for (auto i = 0; i < 5; i++) {
+        one_and_half.insert(i);
+        additive.insert(i);
+    }
+
+    EXPECT_EQ(one_and_half.capacity(), 7);
+    EXPECT_EQ(additive.capacity(), 7);
+
+    for (auto i = 0; i < 3; i++) {
+        one_and_half.insert(i);
+        additive.insert(i);
+    }
+
+    EXPECT_EQ(one_and_half.capacity(), 11);
+    EXPECT_EQ(additive.capacity(), 10);
+    EXPECT_EQ(one_and_half[7], 2);
+    EXPECT_EQ(additive[7], 2);
+
+    additive.insert(0, 10, 1);
+
+    EXPECT_EQ(additive.size(), 18);
+    EXPECT_EQ(additive.capacity(), 19);
+}
+
+// Memory resource which counts the allocated and freed bytes
+// taking the memory from the default resource.
+class CountingResource : public std::pmr::memory_resource {
+public:
+    std::size_t allocated = 0, deallocated = 0;
+private:
+    void *do_allocate(std::size_t bytes, std::size_t alignment) override {
+        allocated += bytes;
+        return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+    }
+    void do_deallocate(void *memory, std::size_t bytes, std::size_t alignment) override {
+        deallocated += bytes;
+        std::pmr::new_delete_resource()->deallocate(memory, bytes, alignment);
+    }
+    bool do_is_equal(const std::pmr::memory_resource &other) const noexcept override {
+        return this == &other;
+    }
+};
+
+// The test checks that the memory of the array is taken from the
+// std::pmr resource, the copy takes the default resource
+// and the move to the array with another resource moves the elements.
+TEST(DynamicArrayTest, StringType_PolymorphicAllocator) {
+    using PmrArray = Array<std::string, DoublingGrowth,
+                           std::pmr::polymorphic_allocator<std::string>>;
+    CountingResource resource, other_resource;
+    {
+        PmrArray array(2, &resource);
+        for (auto i = 0; i < 10; i++) array.insert(std::to_string(i));
+
+        EXPECT_EQ(array.get_allocator().resource(), &resource);
+        EXPECT_EQ(resource.allocated, (2 + 4 + 8 + 16) * sizeof(std::string));
+
+        PmrArray copy(array);
+
+        EXPECT_EQ(copy.get_allocator().resource(), std::pmr::get_default_resource());
+        EXPECT_EQ(copy[9], "9");
+
+        PmrArray other(&other_resource);
+        other = std::move(array);
+
+        EXPECT_EQ(other.get_allocator().resource(), &other_resource);
+        EXPECT_EQ(array.size(), 0);
+        EXPECT_EQ(other.size(), 10);
+        for (auto i = 0; i < 10; i++) EXPECT_EQ(other[i], std::to_string(i));
+    }
+    EXPECT_EQ(resource.allocated, resource.deallocated);
+    EXPECT_EQ(other_resource.allocated, other_resource.deallocated);
+}
+
+// The test checks that the growing array takes all memory
+// from the buffer of the monotonic resource.
+TEST(DynamicArrayTest, SimpleType_MonotonicBuffer) {
+    char buffer[1024];
+    std::pmr::monotonic_buffer_resource monotonic(
+            buffer, sizeof(buffer), std::pmr::null_memory_resource());
+    Array<int, DoublingGrowth, std::pmr::polymorphic_allocator<int>> array(4, &monotonic);
+    for (auto i = 0; i < 50; i++) array.insert(i);
+
+    EXPECT_EQ(array.size(), 50);
+    EXPECT_EQ(array.capacity(), 64);
+    for (auto i = 0; i < 50; i++) EXPECT_EQ(array[i], i);
+}
+
+// The test checks that the small array keeps the elements
+// inside the object until they do not fit
+// and returns them back after shrink_to_fit.
+TEST(DynamicArrayTest, SimpleType_SmallArrayInline) {
+    CountingResource resource;
+    {
+        SmallArray<int, 4, DoublingGrowth, std::pmr::polymorphic_allocator<int>>
+                array(&resource);
+        for (auto i = 0; i < 4; i++) array.insert(i);
+
+        EXPECT_EQ(array.capacity(), 4);
+        EXPECT_EQ(resource.allocated, 0);
+
+        array.insert(4);
+
+        EXPECT_EQ(array.capacity(), 8);
+        EXPECT_EQ(resource.allocated, 8 * sizeof(int));
+
+        array.erase(0, 2);
+        array.shrink_to_fit();
+
+        EXPECT_EQ(array.capacity(), 4);
+        EXPECT_EQ(resource.deallocated, resource.allocated);
+        EXPECT_EQ(array.size(), 3);
+        for (auto i = 0; i < 3; i++) EXPECT_EQ(array[i], i + 2);
+    }
+    EXPECT_EQ(resource.deallocated, resource.allocated);
+}
+
+// The test checks the copy and the move of the small arrays
+// with the inline elements and with the allocated memory.
+TEST(DynamicArrayTest, StringType_SmallArrayCopyMove) {
+    SmallArray<std::string, 2> small, large;
+    small.insert("a");
+    for (auto i = 0; i < 5; i++) large.insert(std::string(20, 'a' + i));
+
+    SmallArray<std::string, 2> small_copy(small), large_copy(large);
+    SmallArray<std::string, 2> small_moved(std::move(small_copy)),
+            large_moved(std::move(large_copy));
+
+    EXPECT_EQ(small_copy.size(), 0);
+    EXPECT_EQ(small_copy.capacity(), 2);
+    EXPECT_EQ(large_copy.size(), 0);
+    EXPECT_EQ(large_copy.capacity(), 2);
+    EXPECT_EQ(small_moved.size(), 1);
+    EXPECT_EQ(small_moved[0], "a");
+    EXPECT_EQ(large_moved.size(), 5);
+    EXPECT_EQ(large_moved[4], std::string(20, 'e'));
+
+    small_moved = std::move(large_moved);
+    large_moved = std::move(small);
+
+    EXPECT_EQ(small_moved.size(), 5);
+    EXPECT_EQ(small_moved[0], std::string(20, 'a'));
+    EXPECT_EQ(large_moved.size(), 1);
+    EXPECT_EQ(large_moved.capacity(), 2);
+    EXPECT_EQ(large_moved[0], "a");
+
+    large_moved.insert("b");
+    small_moved = large_moved;
+
+    EXPECT_EQ(small_moved.size(), 2);
+    EXPECT_EQ(small_moved.capacity(), 2);
+    EXPECT_EQ(small_moved[1], "b");
+    EXPECT_TRUE(std::is_nothrow_move_constructible_v<decltype(small)>);
+}
+
+// The test checks the access to the elements without the check of the index
+// and through the pointer to the data.
+TEST(DynamicArrayTest, SimpleType_UncheckedAccess) {
+    Array<int> array;
+    for (auto i = 0; i < 5; i++) array.insert(i);
+    const auto &const_array = array;
+
+    array.at(2) = 10;
+
+    EXPECT_EQ(const_array.at(2), 10);
+    EXPECT_EQ(array.data(), &array[0]);
+    EXPECT_EQ(const_array.data()[4], 4);
+}
+
+// The test checks the range-for and the standard algorithms
+// with the contiguous iterators of the array.
+TEST(DynamicArrayTest, SimpleType_ContiguousIterators) {
+    static_assert(std::contiguous_iterator<decltype(Array<int>().begin())>);
+    Array<int> array(4);
+    for (auto i = 10; i > 0; i--) array.insert(i);
+
+    for (auto &elem : array) elem *= 2;
+    std::sort(array.begin(), array.end());
+
+    EXPECT_EQ(array.end() - array.begin(), array.size());
+    EXPECT_EQ(std::accumulate(array.begin(), array.end(), 0), 110);
+    for (std::size_t i = 0; i < array.size(); i++)
+        EXPECT_EQ(array[i], 2 * static_cast<int>(i + 1));
+
+    Array<int> empty(0);
+    empty.shrink_to_fit();
+
+    EXPECT_EQ(empty.begin(), empty.end());
+}
+
+// Growth policy which overflows the capacity.
+struct OverflowGrowth {
+    static std::size_t grow(std::size_t capacity) {
+        return capacity + std::numeric_limits<std::size_t>::max() - 1;
+    }
+};
+
+// Allocator which gives the memory for small_max_size elements at most.
+template<typename T>
+struct SmallAllocator : MallocAllocator<T> {
+    using value_type = T;
+    static constexpr std::size_t small_max_size = 1000;
+    SmallAllocator() = default;
+    template<typename U>
+    SmallAllocator(const SmallAllocator<U> &) noexcept {}
+    std::size_t max_size() const noexcept {return small_max_size;}
+};
+
+// The test checks the sizes of the type size_t
+// and that the overflow of the growth or of the size is detected.
+TEST(DynamicArrayTest, SimpleType_SizeOverflow) {
+    static_assert(std::is_same_v<decltype(Array<char>().size()), std::size_t>);
+    Array<int, OverflowGrowth> array(4);
+    for (auto i = 0; i < 5; i++) array.insert(i);
+
+    EXPECT_EQ(array.capacity(), 5);
+    EXPECT_EQ(array[4], 4);
+
+    array.insert(0, array.max_size(), 1);
+    array.reserve(array.max_size() + 1);
+
+    EXPECT_EQ(array.size(), 5);
+    EXPECT_EQ(array.capacity(), 5);
+    EXPECT_LE(array.max_size(), std::numeric_limits<std::ptrdiff_t>::max() / sizeof(int));
+
+    Array<char, DoublingGrowth, SmallAllocator<char>> small;
+    const auto limit = SmallAllocator<char>::small_max_size;
+    small.insert(0, limit + 1, 'a');
+
+    EXPECT_EQ(small.max_size(), limit);
+    EXPECT_EQ(small.size(), 0);
+
+    small.insert(0, limit - 1, 'a');
+    small.insert(std::size_t(0), 'b');
+
+    EXPECT_EQ(small.size(), limit);
+    EXPECT_EQ(small.capacity(), limit);
+
+    small.insert('c');
+    small.reserve(limit + 1);
+
+    EXPECT_EQ(small.size(), limit);
+    EXPECT_EQ(small.capacity(), limit);
+    EXPECT_EQ(small.at(0), 'b');
+    EXPECT_EQ(small.at(limit - 1), 'a');
+}
+
+// The test checks that the huge array grows and shrinks in place,
+// so the pointers to the elements stay valid.
+TEST(DynamicArrayTest, SimpleType_HugeArrayInPlace) {
+    HugeArray<long> array(1, MappedAllocator<long>(std::size_t(1) << 30, true));
+    array.insert(0);
+    auto first = &array[0];
+    for (long i = 1; i < (1 << 20); i++) array.insert(i);
+
+    EXPECT_EQ(&array[0], first);
+    EXPECT_EQ(array.capacity(), std::size_t(1) << 20);
+    for (long i = 0; i < (1 << 20); i += 4099) EXPECT_EQ(array[i], i);
+
+    array.erase(1000, array.size());
+    array.shrink_to_fit();
+
+    EXPECT_EQ(array.data(), first);
+    EXPECT_EQ(array.capacity(), 1000);
+    EXPECT_EQ(array[999], 999);
+}
+
+// The test checks that the elements with constructors stay in place
+// and the capacity is limited by the reserved range.
+TEST(DynamicArrayTest, StringType_HugeArrayReserve) {
+    auto reserve = 1 << 16;
+    HugeArray<std::string> array(4, MappedAllocator<std::string>(reserve));
+    array.insert(std::string(50, 'a'));
+    auto first = array.data();
+    auto max_size = array.max_size();
+    while (array.size() < max_size) array.insert("b");
+
+    EXPECT_EQ(max_size, reserve / sizeof(std::string));
+    EXPECT_EQ(array.data(), first);
+    EXPECT_EQ(array[0], std::string(50, 'a'));
+
+    array.insert("c");
+
+    EXPECT_EQ(array.size(), max_size);
+    EXPECT_EQ(array[max_size - 1], "b");
+}
+
+// The test checks that the persistent array keeps its elements
+// in the file after the growth and is reopened with them,
+// and that the open file is locked for another object.
+TEST(DynamicArrayTest, SimpleType_PersistentArrayReopen) {
+    auto path = getTemporaryPath("persistent_array_reopen");
+    std::filesystem::remove(path);
+    {
+        PersistentArray<int> array(path.string(), 4);
+        for (auto i = 0; i < 1000; i++) array.insert(i);
+
+        EXPECT_EQ(array.capacity(), 1024);
+        EXPECT_TRUE(array.sync());
+    }
+    {
+        PersistentArray<int> array(path.string());
+
+        EXPECT_THROW(PersistentArray<int> locked(path.string()), std::runtime_error);
+        EXPECT_EQ(array.size(), 1000);
+        EXPECT_EQ(array.capacity(), 1024);
+        for (auto i = 0; i < 1000; i++) EXPECT_EQ(array[i], i);
+
+        array.remove(0);
+        array.insert(0, -1);
+        array.at(1) = 10;
+    }
+    PersistentArray<int> array(path.string());
+
+    EXPECT_EQ(array.size(), 1000);
+    EXPECT_EQ(array[0], -1);
+    EXPECT_EQ(array[1], 10);
+    EXPECT_EQ(*(array.end() - 1), 999);
+    EXPECT_THROW(array[1000], std::invalid_argument);
+    std::filesystem::remove(path);
+}
+
+// The test checks that clear shortens the file to the default capacity
+// and the cleared array is reopened and grows again.
+TEST(DynamicArrayTest, SimpleType_PersistentArrayClear) {
+    auto path = getTemporaryPath("persistent_array_clear");
+    std::filesystem::remove(path);
+    {
+        PersistentArray<long> array(path.string());
+        for (auto i = 0; i < 1000; i++) array.insert(i);
+        auto full_length = std::filesystem::file_size(path);
+
+        array.clear();
+
+        EXPECT_EQ(array.size(), 0);
+        EXPECT_EQ(array.capacity(), const_array::array_capacity);
+        EXPECT_LT(std::filesystem::file_size(path), full_length);
+    }
+    PersistentArray<long> array(path.string());
+
+    EXPECT_EQ(array.size(), 0);
+    EXPECT_EQ(array.capacity(), const_array::array_capacity);
+    for (auto i = 0; i < 100; i++) array.insert(i);
+    EXPECT_EQ(array[99], 99);
+    std::filesystem::remove(path);
+}
+
+// The test checks that the file of another type or without the header
+// is not opened as the persistent array.
+TEST(DynamicArrayTest, SimpleType_PersistentArrayIncorrectFile) {
+    auto path = getTemporaryPath("persistent_array_incorrect");
+    std::filesystem::remove(path);
+    {
+        PersistentArray<int> array(path.string());
+        array.insert(1);
+    }
+
+    EXPECT_THROW(PersistentArray<double> array(path.string()), std::runtime_error);
+
+    std::ofstream(path, std::ios::trunc) << "not an array";
+
+    EXPECT_THROW(PersistentArray<int> array(path.string()), std::runtime_error);
+    std::filesystem::remove(path);
+}
+
 /*
  * Tests for iterator`s functions
  */
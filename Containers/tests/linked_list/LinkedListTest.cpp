@@ -11,6 +11,7 @@
  */
 
 #include "gtest/gtest.h"
+#include <memory_resource>
 #include <random>
 #include <ctime>
 
@@ -728,6 +729,50 @@ TEST(LinkedListTest, ComplexType_RemoveTail_Large) {
     EXPECT_EQ(output_message, "");
 }
 
+// Memory resource which counts the allocated and freed bytes
+// taking the memory from the default resource.
+class CountingResource : public std::pmr::memory_resource {
+public:
+    std::size_t allocated = 0, deallocated = 0;
+private:
+    void *do_allocate(std::size_t bytes, std::size_t alignment) override {
+        allocated += bytes;
+        return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+    }
+    void do_deallocate(void *memory, std::size_t bytes, std::size_t alignment) override {
+        deallocated += bytes;
+        std::pmr::new_delete_resource()->deallocate(memory, bytes, alignment);
+    }
+    bool do_is_equal(const std::pmr::memory_resource &other) const noexcept override {
+        return this == &other;
+    }
+};
+
+// The test checks that the chunks of the list are taken from the
+// std::pmr resource and all of them are given back to it,
+// including the chunks removed from the head and the tail.
+TEST(LinkedListTest, SimpleType_PolymorphicAllocator) {
+    CountingResource resource;
+    {
+        List<int, std::pmr::polymorphic_allocator<int>> list(&resource);
+        for (auto i = 0; i < 100; i++) list.insertTail(i);
+
+        EXPECT_EQ(list.get_allocator().resource(), &resource);
+        EXPECT_GT(resource.allocated, 100 * sizeof(int));
+
+        for (auto i = 0; i < 30; i++) {
+            list.removeHead();
+            list.removeTail();
+        }
+
+        EXPECT_EQ(list.size(), 40);
+        EXPECT_EQ(list.head(), 30);
+        EXPECT_EQ(list.tail(), 69);
+        EXPECT_GT(resource.deallocated, 0);
+    }
+    EXPECT_EQ(resource.allocated, resource.deallocated);
+}
+
 /*
  * Tests for iterator`s functions
  */
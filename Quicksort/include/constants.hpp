@@ -1,10 +1,13 @@
 /**
- * All numeric constants from TimeMeter and Sorter.
+ * All numeric constants from TimeMeter, Sorter, Merger and SortedBuffer.
  */
 
 #ifndef QUICKSORT_CONSTANTS_HPP
 #define QUICKSORT_CONSTANTS_HPP
 
+#include <cstddef>
+#include <cstdint>
+
 #define LESS(T) [](T a, T b) {return a < b;}
 #define GREATER(T) [](T a, T b) {return a > b;}
 #define LESS_OR_EQUAL(T) [](T a, T b) {return a <= b;}
@@ -12,23 +15,94 @@
 
 #define EMPTY_ARRAY_MESSAGE ""
 #define ILLEGAL_ARG_ARRAY_EXC_MESSAGE "Error in setting the array\n"
+#define ILLEGAL_ARG_RANGE_EXC_MESSAGE "Error in setting the range of keys\n"
 #define ILLEGAL_ARG_COMP_EXC_MESSAGE "Error in compare for this type\n"
 #define NULLPTR_EXC_START_MESSAGE "Empty pointer instead array`s beginning\n"
 #define NULLPTR_EXC_LAST_MESSAGE "Empty pointer instead array`s end\n"
+#define NULLPTR_EXC_OUTPUT_MESSAGE "Empty pointer instead output array\n"
+#define ILLEGAL_ARG_RUNS_EXC_MESSAGE "Error in setting the merged arrays\n"
 #define UNEXPECTED_MES "Unexpected error "
+#define FILE_OPEN_EXC_MESSAGE "Error in opening the file "
+#define FILE_MAP_EXC_MESSAGE "Error in mapping the file "
+#define FILE_WRITE_EXC_MESSAGE "Error in writing the sorted lines\n"
+#define ILLEGAL_ARG_FIELD_EXC_MESSAGE "Error in setting the field number\n"
+#define LINES_USAGE_MESSAGE "Usage: Quicksort LINES [-t delimiter] [-k field] path"
+#define SHARED_MEMORY_EXC_MESSAGE "Error in mapping the shared memory "
+#define PROCESS_EXC_MESSAGE "Error in the sorting process\n"
 
 namespace constants {
     namespace sorter {
         const auto insert_len(14);
+        // with binary search of the place longer intervals are sorted by inserts
+        const auto binary_insert_len(32);
+        // number of elements of the sample for choosing the cost of the predicate
+        const auto calibration_len(1024);
+        // number of sorts of the sample by each kind of inserts for choosing the cost
+        const auto calibration_rounds(3);
+
+        // the partition is unbalanced if its shorter part is less than 1/ratio
+        const auto unbalanced_ratio(8);
+        // number of lines written by one series of writev calls
+        const std::size_t write_batch_len(1 << 14);
+        // shorter intervals are not sent to other threads
+        const auto parallel_len(1 << 15);
+        // number of threads running the background sortings
+        const unsigned async_thread_count(4);
+        // shorter intervals are sorted by one process
+        const auto process_len(1 << 15);
+        // shorter arrays of keys are sorted faster by quicksort than by bytes
+        const auto radix_len(256);
+        // rows of a payload column are requested from memory in advance
+        const auto prefetch_distance(16);
+        // used if the size of L2 cache is unknown
+        const std::size_t l2_size_default(256 * 1024);
+        // number of sorted blocks merged at a time
+        const std::size_t merge_fan_in(64);
+        // shorter arrays are sorted without the search of sorted runs
+        const auto presorted_min_len(64);
+        // arrays with more sorted runs are sorted by quicksort
+        const std::size_t presorted_max_runs(16);
+        // 8 MB of counters - larger ranges are sorted by quicksort
+        const std::uint64_t counting_max_range(1 << 20);
+        // number of elements for estimating the range of values
+        const auto counting_sample_len(256);
+        // shorter arrays are counted in one thread
+        const auto counting_parallel_len(1 << 20);
+    }
+    namespace merger {
+        // 256 elements of type int are 1 KB - several buffers fit in L1
+        const auto block_len(256);
+        // shorter outputs are merged faster without starting threads
+        const auto parallel_min_len(1 << 16);
+    }
+    namespace sorted_buffer {
+        // the appended values are sorted by batches of this length
+        const auto batch_len(1024);
     }
     namespace time_meter {
-        const auto experiment_count_default(3);
-        const auto experiment_count_limit(50);
+        const auto experiment_count_default(15);
+        const auto experiment_count_min(1);
+        const auto experiment_count_limit(1000);
+        const auto warmup_count_default(3);
+        const unsigned seed_default(20201218);
+        // pin to the first processor
+        const auto cpu_default(0);
+        // number of arrays sorted in one repetition (short arrays are too fast)
+        const auto batch_count(1000);
+        // arrays are not longer than this length in the experiment
+        const auto length_limit(256);
+        // the length returned if the experiment fails
         const auto result_default(10);
+        // the measurement is disturbed if the frequency changed more than by 5%
+        const auto frequency_tolerance(0.05);
+        // or the median absolute deviation is more than 10% of the median
+        const auto noise_tolerance(0.1);
     }
 }
 
 namespace const_sort = constants::sorter;
+namespace const_merge = constants::merger;
+namespace const_buffer = constants::sorted_buffer;
 namespace const_time_meter = constants::time_meter;
 
 #endif //QUICKSORT_CONSTANTS_HPP
@@ -0,0 +1,21 @@
+/**
+ * Sizes of the processor caches
+ * for choosing the length of the blocks sorted in the cache.
+ */
+
+#ifndef QUICKSORT_CACHE_INFO_HPP
+#define QUICKSORT_CACHE_INFO_HPP
+
+#include <cstddef>
+
+// Returns the size in bytes of the data (or unified) cache
+// of the level for the first processor,
+// 0 if the size is unknown (information from sysfs is unavailable).
+std::size_t cache_size(int);
+
+// Returns the size in bytes of the block sorted in the cache:
+// half of L2 (l2_size_default if it is unknown),
+// sysfs is read once on the first call.
+std::size_t cache_block_size();
+
+#endif //QUICKSORT_CACHE_INFO_HPP
@@ -0,0 +1,52 @@
+/**
+ * Total order of floating-point numbers
+ * (IEEE 754 totalOrder) by their bits.
+ */
+
+#ifndef QUICKSORT_FLOAT_ORDER_HPP
+#define QUICKSORT_FLOAT_ORDER_HPP
+
+#include <bit>
+#include <cstdint>
+#include <type_traits>
+
+// Comparison of floating-point numbers in the total order:
+// -NaN < -inf < ... < -0.0 < +0.0 < ... < +inf < +NaN.
+// Unlike LESS(T) every pair of values is ordered, so NaNs can be sorted.
+#define TOTAL_ORDER_LESS(T) [](T a, T b) {\
+    return total_order_key(a) < total_order_key(b);}
+
+// Unsigned integer of the same size as the floating-point type.
+template<typename T>
+using float_key_t = std::conditional_t<sizeof(T) == sizeof(std::uint32_t),
+        std::uint32_t, std::uint64_t>;
+
+// The function maps the bits of the number to the unsigned integer
+// which is ordered as the number in the total order:
+// the sign bit is inverted for positive numbers
+// and all bits are inverted for negative ones.
+/// \tparam T - float or double
+/// \param value - the number
+/// \return - key of the number
+template<typename T>
+    requires std::is_floating_point_v<T> && (sizeof(T) == sizeof(float_key_t<T>))
+float_key_t<T> total_order_key(T value) {
+    using Key = float_key_t<T>;
+    auto bits = std::bit_cast<Key>(value);
+    const Key sign = Key(1) << (sizeof(Key) * 8 - 1);
+    return (bits & sign) ? ~bits : (bits | sign);
+}
+
+// The function restores the number from its key.
+/// \tparam T - float or double
+/// \param key - key of the number
+/// \return - the number
+template<typename T>
+    requires std::is_floating_point_v<T> && (sizeof(T) == sizeof(float_key_t<T>))
+T from_total_order_key(float_key_t<T> key) {
+    using Key = float_key_t<T>;
+    const Key sign = Key(1) << (sizeof(Key) * 8 - 1);
+    return std::bit_cast<T>((key & sign) ? (key & ~sign) : ~key);
+}
+
+#endif //QUICKSORT_FLOAT_ORDER_HPP
@@ -0,0 +1,51 @@
+/**
+ * Sorting the lines of a text file by a delimited field
+ * (as sort -t<delimiter> -k<field>,<field>).
+ */
+
+#ifndef QUICKSORT_LINE_SORTER_HPP
+#define QUICKSORT_LINE_SORTER_HPP
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "constants.hpp"
+#include "sorter/sorter.hpp"
+
+// Sorts the lines of the text by the field with the number field
+// (from 1, fields are separated by the delimiter, a line without
+// the field has the empty key), the lines with equal keys
+// are ordered by the whole lines.
+// The file is mapped into memory and is not copied:
+// the lines are sorted as descriptors (string_view of the line and the key)
+// with the first 8 bytes of the key cached as an integer,
+// so most comparisons do not read the text.
+// The sorted lines are written by one gather pass (writev).
+// Example:
+//      LineSorter line_sorter(',', 3);
+//      line_sorter.sort_file("data.csv", STDOUT_FILENO);
+class LineSorter {
+    char delimiter;
+    int field;
+    Sorter sorter;
+public:
+    // Descriptor of the line of the text.
+    struct Line {
+        std::string_view text;
+        std::string_view key;
+        // first bytes of the key in big-endian order (0 after the end)
+        std::uint64_t prefix;
+    };
+
+    explicit LineSorter(char delimiter = '\t', int field = 1);
+
+    std::vector<Line> sort_lines(std::string_view);
+    void sort_file(const std::string &, int);
+private:
+    Line describe(std::string_view) const;
+    static void write_lines(const std::vector<Line> &, int);
+};
+
+#endif //QUICKSORT_LINE_SORTER_HPP
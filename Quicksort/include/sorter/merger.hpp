@@ -0,0 +1,328 @@
+/**
+ * Merging several sorted template arrays into one
+ * using a tournament (loser) tree.
+ */
+
+#ifndef QUICKSORT_MERGER_HPP
+#define QUICKSORT_MERGER_HPP
+
+#include <algorithm>
+#include <exception>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "constants.hpp"
+
+// Sorted interval [first; last) which is one of the merge inputs.
+template<typename T>
+struct SortedRun {
+    T *first;
+    T *last;
+
+    long size() const {return last - first;}
+};
+
+// Merging k sorted arrays into one sorted array.
+// Each input is read by blocks into its own buffer,
+// the smallest of the current elements is chosen by the loser tree
+// with log(k) comparisons for each output element.
+// Equal elements are taken in the order of the inputs (the merge is stable).
+// With several threads the output is divided into equal parts by co-ranking,
+// and each part is merged independently.
+// Example:
+//      int a[] = {1, 4, 7}, b[] = {2, 5}, c[] = {3, 6};
+//      SortedRun<int> runs[] = {{a, a + 3}, {b, b + 2}, {c, c + 2}};
+//      int result[7];
+//      Merger merger;
+//      merger.merge(runs, runs + 3, result, LESS(int));
+class Merger {
+    // number of elements read from the input at a time
+    int block_length;
+    // number of threads for merging, 1 - without parallelism
+    int thread_count;
+public:
+    explicit Merger(int block_init_length = const_merge::block_len,
+                    int thread_init_count = 1)
+    : block_length(block_init_length > 0 ?
+                   block_init_length : const_merge::block_len),
+    thread_count(thread_init_count > 0 ? thread_init_count : 1) {}
+
+    template<typename T, typename Compare>
+        void merge(SortedRun<T> *, SortedRun<T> *, T *, Compare);
+    template<typename T, typename Compare>
+        void split(const SortedRun<T> *, const SortedRun<T> *, long, long *, Compare) const;
+private:
+    template<typename T, typename Compare>
+        void sequential_merge(const SortedRun<T> *, const SortedRun<T> *, T *, Compare);
+    template<typename T, typename Compare>
+        void parallel_merge(const SortedRun<T> *, const SortedRun<T> *, T *, long, Compare);
+    template<typename T, typename Compare>
+        long rank(const SortedRun<T> *, const SortedRun<T> *, int, const T &,
+                  Compare) const;
+
+// Auxiliary Class
+    // The tournament tree in which each internal node keeps
+    // the input that lost the comparison in it,
+    // and the winner of the whole tree is kept separately.
+    template<typename T, typename Compare>
+    class LoserTree {
+        struct Source {
+            T *next, *last;
+            std::vector<T> buffer;
+            std::size_t position;
+        };
+        std::vector<Source> sources;
+        std::vector<int> losers;
+        int winner;
+        int block_length;
+        Compare comp;
+    public:
+        LoserTree(const SortedRun<T> *, const SortedRun<T> *, int, Compare);
+
+        bool empty() const {return isExhausted(winner);}
+        T &top() {return sources[winner].buffer[sources[winner].position];}
+        void pop();
+    private:
+        bool isExhausted(int) const;
+        bool isBeating(int, int) const;
+        void fill(Source &);
+        int build(int);
+    };
+};
+
+/*
+ * MERGE
+ */
+
+// The function merges sorted inputs into the output array.
+// The output must not overlap with the inputs.
+/// \tparam T - type of array elements
+/// \tparam Compare - type of predicat
+/// \param first - pointer to the first input
+/// \param last - pointer to an input after the last one
+/// \param out - pointer to the beginning of the output array
+/// with the place for all elements of the inputs
+/// \param comp - the comparison predicate for the specified types
+template<typename T, typename Compare>
+void Merger::merge(SortedRun<T> *first, SortedRun<T> *last, T *out, Compare comp) {
+    if ((first == nullptr) || (last == nullptr) || (last < first))
+        throw std::invalid_argument(ILLEGAL_ARG_RUNS_EXC_MESSAGE);
+    long total = 0;
+    for (auto run = first; run < last; run++) {
+        if (run->size() < 0)
+            throw std::invalid_argument(ILLEGAL_ARG_RUNS_EXC_MESSAGE);
+        total += run->size();
+    }
+    if (total == 0) return;
+    if (out == nullptr) throw std::invalid_argument(NULLPTR_EXC_OUTPUT_MESSAGE);
+    if ((thread_count > 1) && (total >= const_merge::parallel_min_len))
+        parallel_merge(first, last, out, total, comp);
+    else sequential_merge(first, last, out, comp);
+}
+
+// The function merges the inputs in the current thread.
+/// \tparam T - type of array elements
+/// \tparam Compare - type of predicat
+/// \param first - pointer to the first input
+/// \param last - pointer to an input after the last one
+/// \param out - pointer to the beginning of the output array
+/// \param comp - the comparison predicate for the specified types
+template<typename T, typename Compare>
+void Merger::sequential_merge(const SortedRun<T> *first, const SortedRun<T> *last,
+                              T *out, const Compare comp) {
+    if ((last - first) == 1) {
+        std::copy(first->first, first->last, out);
+        return;
+    }
+    LoserTree<T, Compare> tree(first, last, block_length, comp);
+    while (!tree.empty()) {
+        *out++ = std::move(tree.top());
+        tree.pop();
+    }
+}
+
+// The function divides the output into thread_count equal parts,
+// finds by co-ranking which part of every input goes to each of them
+// and merges the parts in separate threads.
+/// \tparam T - type of array elements
+/// \tparam Compare - type of predicat
+/// \param first - pointer to the first input
+/// \param last - pointer to an input after the last one
+/// \param out - pointer to the beginning of the output array
+/// \param total - number of elements in all inputs
+/// \param comp - the comparison predicate for the specified types
+template<typename T, typename Compare>
+void Merger::parallel_merge(const SortedRun<T> *first, const SortedRun<T> *last, T *out,
+                            long total, const Compare comp) {
+    auto count = last - first;
+    std::vector<long> borders((thread_count + 1) * count);
+    for (auto part = 0; part <= thread_count; part++)
+        split(first, last, total * part / thread_count,
+              borders.data() + part * count, comp);
+
+    std::vector<std::exception_ptr> errors(thread_count);
+    std::vector<std::thread> threads;
+    for (auto part = 0; part < thread_count; part++)
+        threads.emplace_back([=, this, &borders, &errors]() {
+            try {
+                std::vector<SortedRun<T>> parts(count);
+                for (auto i = 0; i < count; i++)
+                    parts[i] = {first[i].first + borders[part * count + i],
+                                first[i].first + borders[(part + 1) * count + i]};
+                sequential_merge(parts.data(), parts.data() + count,
+                                 out + total * part / thread_count, comp);
+            }
+            catch (...) {
+                errors[part] = std::current_exception();
+            }
+        });
+    for (auto &thread : threads) thread.join();
+    for (auto &error : errors) if (error) std::rethrow_exception(error);
+}
+
+/*
+ * CO-RANKING
+ */
+
+// The function finds how many elements of each input
+// are placed before the position out_rank of the merged output.
+/// \tparam T - type of array elements
+/// \tparam Compare - type of predicat
+/// \param first - pointer to the first input
+/// \param last - pointer to an input after the last one
+/// \param out_rank - position in the merged output
+/// \param borders - array with the place for the number of elements
+/// for each input
+/// \param comp - the comparison predicate for the specified types
+template<typename T, typename Compare>
+void Merger::split(const SortedRun<T> *first, const SortedRun<T> *last, long out_rank,
+                   long *borders, const Compare comp) const {
+    for (auto i = 0; i < (last - first); i++) {
+        long low = 0, high = first[i].size();
+        while (low < high) {
+            auto middle = low + (high - low) / 2;
+            if (rank(first, last, i, first[i].first[middle], comp) + middle
+                < out_rank)
+                low = middle + 1;
+            else high = middle;
+        }
+        borders[i] = low;
+    }
+}
+
+// The function counts the elements of other inputs
+// which are placed before the element of the input with the index
+// in the merged output.
+/// \tparam T - type of array elements
+/// \tparam Compare - type of predicat
+/// \param first - pointer to the first input
+/// \param last - pointer to an input after the last one
+/// \param index - index of the input of the element
+/// \param value - value of the element
+/// \param comp - the comparison predicate for the specified types
+/// \return - number of the elements of other inputs before the element
+template<typename T, typename Compare>
+long Merger::rank(const SortedRun<T> *first, const SortedRun<T> *last, int index,
+                  const T &value, const Compare comp) const {
+    long result = 0;
+    for (auto i = 0; i < (last - first); i++) {
+        if (i < index)
+            result += std::upper_bound(first[i].first, first[i].last,
+                                       value, comp) - first[i].first;
+        else if (i > index)
+            result += std::lower_bound(first[i].first, first[i].last,
+                                       value, comp) - first[i].first;
+    }
+    return result;
+}
+
+/*
+ * Methods of LoserTree
+ */
+
+// The constructor reads the first block of every input
+// and plays all the matches of the tree.
+/// \tparam T - type of array elements
+/// \tparam Compare - type of predicat
+/// \param first - pointer to the first input
+/// \param last - pointer to an input after the last one
+/// \param block_length - number of elements read from the input at a time
+/// \param comp - the comparison predicate for the specified types
+template<typename T, typename Compare>
+Merger::LoserTree<T, Compare>::LoserTree(
+        const SortedRun<T> *first, const SortedRun<T> *last, int block_length,
+        Compare comp)
+: sources(last - first), losers(last - first), winner(0),
+block_length(block_length), comp(comp) {
+    for (auto i = 0; i < (last - first); i++) {
+        sources[i].next = first[i].first;
+        sources[i].last = first[i].last;
+        sources[i].buffer.reserve(std::min<long>(block_length, first[i].size()));
+        fill(sources[i]);
+    }
+    if (!sources.empty()) winner = build(1);
+}
+
+// The function removes the winner and replays the matches
+// on the path from its leaf to the root.
+template<typename T, typename Compare>
+void Merger::LoserTree<T, Compare>::pop() {
+    auto &source = sources[winner];
+    if (++source.position == source.buffer.size()) fill(source);
+    auto count = static_cast<int>(sources.size());
+    for (auto node = (winner + count) / 2; node > 0; node /= 2)
+        if (isBeating(losers[node], winner)) std::swap(losers[node], winner);
+}
+
+// The function checks whether all elements of the input were taken.
+/// \param index - index of the input
+template<typename T, typename Compare>
+bool Merger::LoserTree<T, Compare>::isExhausted(int index) const {
+    return sources[index].position == sources[index].buffer.size();
+}
+
+// The function checks whether the current element of the first input
+// goes to the output before the current element of the second one.
+/// \param first - index of the first input
+/// \param second - index of the second input
+template<typename T, typename Compare>
+bool Merger::LoserTree<T, Compare>::isBeating(int first, int second) const {
+    if (isExhausted(first)) return false;
+    if (isExhausted(second)) return true;
+    const auto &a = sources[first].buffer[sources[first].position];
+    const auto &b = sources[second].buffer[sources[second].position];
+    if (comp(a, b)) return true;
+    if (comp(b, a)) return false;
+    return first < second;
+}
+
+// The function reads the next block of the input into its buffer.
+/// \param source - the input
+template<typename T, typename Compare>
+void Merger::LoserTree<T, Compare>::fill(Source &source) {
+    auto length = std::min<long>(block_length, source.last - source.next);
+    source.buffer.assign(source.next, source.next + length);
+    source.next += length;
+    source.position = 0;
+}
+
+// The function plays the matches of the subtree
+// (leaves of the tree are the inputs with numbers from count to 2 * count - 1).
+/// \param node - number of the root of the subtree
+/// \return - index of the input that won in the subtree
+template<typename T, typename Compare>
+int Merger::LoserTree<T, Compare>::build(int node) {
+    auto count = static_cast<int>(sources.size());
+    if (node >= count) return node - count;
+    auto left = build(2 * node), right = build(2 * node + 1);
+    if (isBeating(left, right)) {
+        losers[node] = right;
+        return left;
+    }
+    losers[node] = left;
+    return right;
+}
+
+#endif //QUICKSORT_MERGER_HPP
@@ -0,0 +1,179 @@
+/**
+ * Sorting an template array in shared memory
+ * by several processes.
+ */
+
+#ifndef QUICKSORT_PROCESS_SORTER_HPP
+#define QUICKSORT_PROCESS_SORTER_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <functional>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include <sys/types.h>
+
+#include "constants.hpp"
+#include "sorter/sorter.hpp"
+
+// Segment of POSIX shared memory (shm_open) mapped into the process.
+// The segment created by the name is removed by its creator in the destructor,
+// other processes can map it by the name while it exists.
+// Example:
+//      SharedSegment segment("/numbers", 1000 * sizeof(int));
+//      auto array = segment.as<int>();
+class SharedSegment {
+    std::string name;
+    void *data;
+    std::size_t length;
+    bool owner;
+public:
+    SharedSegment(std::string, std::size_t);
+    explicit SharedSegment(std::string);
+    SharedSegment(const SharedSegment &) = delete;
+    SharedSegment &operator =(const SharedSegment &) = delete;
+    ~SharedSegment();
+
+    template<typename T> T *as() const {return static_cast<T *>(data);}
+    std::size_t size() const {return length;}
+private:
+    void map(int);
+};
+
+// Sorting an array in shared memory (SharedSegment or a MAP_SHARED mapping)
+// by the current process and the forked helper processes
+// for the programs which must not start threads.
+// The intervals after partitions are kept in the lock-free queue
+// in the shared memory: each process takes an interval,
+// partitions it while it is longer than process_len,
+// puts the shorter part into the queue and continues with the longer one.
+// The short intervals are sorted by Sorter of the process.
+// The elements must be trivially copyable (the processes share only
+// the memory of the array), the predicate is copied to the helpers by fork.
+// An array outside the shared memory is sorted by the current process only
+// (the helpers would sort their private copies of it).
+// Example:
+//      SharedSegment segment("/numbers", size * sizeof(int));
+//      auto array = segment.as<int>();
+//      ...
+//      ProcessSorter(4).sort(array, array + size, LESS(int));
+class ProcessSorter {
+    // number of processes including the current one
+    int process_count;
+    Sorter sorter;
+
+    // Interval [first; last) of indexes of the array.
+    struct Interval {
+        long first;
+        long last;
+
+        long size() const {return last - first;}
+    };
+
+    // Bounded multi-producer multi-consumer queue of intervals
+    // (each cell has the sequence number telling whether it is free)
+    // with the number of unfinished intervals.
+    // The queue and its cells (after it) are placed in the shared memory
+    // before the forks, so their addresses are the same in all processes.
+    class IntervalQueue {
+        struct Cell {
+            std::atomic<long> sequence;
+            Interval interval;
+        };
+        static_assert(std::atomic<long>::is_always_lock_free);
+        Cell *cells;
+        long mask;
+        alignas(64) std::atomic<long> tail;
+        alignas(64) std::atomic<long> head;
+        alignas(64) std::atomic<long> unfinished;
+        std::atomic<bool> failed;
+    public:
+        explicit IntervalQueue(long);
+
+        static std::size_t memory_size(long);
+        bool push(Interval);
+        bool pop(Interval &);
+        void finish() {unfinished.fetch_sub(1, std::memory_order_acq_rel);}
+        bool isDone() const {return unfinished.load(std::memory_order_acquire) == 0;}
+        void fail() {failed.store(true, std::memory_order_release);}
+        bool isFailed() const {return failed.load(std::memory_order_acquire);}
+    };
+    using IntervalSorting = std::function<void(Interval, IntervalQueue &)>;
+
+public:
+    explicit ProcessSorter(int process_init_count = 0, Sorter sorter = Sorter());
+
+    int size() const {return process_count;}
+    template<typename T, typename Compare> void sort(T *, T *, Compare);
+private:
+    template<typename T, typename Compare>
+        void sort_interval(T *, Interval, Compare, IntervalQueue &);
+    void run(long, const IntervalSorting &);
+    static void work(IntervalQueue &, const IntervalSorting &, std::vector<pid_t> *);
+    static bool isShared(const void *, const void *);
+};
+
+// The function sorts the array in the shared memory by the processes,
+// short arrays and arrays outside the shared memory
+// are sorted in the current process.
+/// \tparam T - trivially copyable type of array elements
+/// \tparam Compare - type of predicat
+/// \param first - pointer to the beginning of the array
+/// \param last - pointer to an element after the end of the array
+/// \param comp - the comparison predicate for the specified types
+template<typename T, typename Compare>
+void ProcessSorter::sort(T *first, T *last, Compare comp) {
+    static_assert(std::is_trivially_copyable_v<T>,
+                  "Elements are shared between processes by their bytes");
+    if (first == nullptr) throw std::invalid_argument(NULLPTR_EXC_START_MESSAGE);
+    if (last == nullptr) throw std::invalid_argument(NULLPTR_EXC_LAST_MESSAGE);
+    if (last < first) throw std::invalid_argument(ILLEGAL_ARG_ARRAY_EXC_MESSAGE);
+    if ((process_count == 1) || ((last - first) < const_sort::process_len) ||
+        !isShared(first, last)) {
+        sorter.sort(first, last, comp);
+        return;
+    }
+    run(last - first, [=, this](Interval interval, IntervalQueue &queue) {
+        sort_interval(first, interval, comp, queue);
+    });
+}
+
+// The function partitions the interval into three parts
+// (less than the pivot, equal and greater) while it is long,
+// gives the shorter part to the queue (or sorts it if the queue is full)
+// and sorts the rest by Sorter.
+/// \tparam T - type of array elements
+/// \tparam Compare - type of predicat
+/// \param array - pointer to the beginning of the array
+/// \param interval - the interval of the array
+/// \param comp - the comparison predicate for the specified types
+/// \param queue - the queue of intervals
+template<typename T, typename Compare>
+void ProcessSorter::sort_interval(T *array, Interval interval, const Compare comp,
+                                  IntervalQueue &queue) {
+    while (interval.size() >= const_sort::process_len) {
+        auto first = array + interval.first, last = array + interval.last - 1;
+        auto middle = first + (last - first) / 2;
+        const T pivot = *(comp(*first, *last) ?
+                (comp(*first, *middle) ? (comp(*middle, *last) ? middle : last) : first) :
+                (comp(*last, *middle) ? (comp(*middle, *first) ? middle : first) : last));
+        auto less_end = std::partition(first, last + 1,
+                [&](const T &elem) {return comp(elem, pivot);});
+        auto greater_begin = std::partition(less_end, last + 1,
+                [&](const T &elem) {return !comp(pivot, elem);});
+        Interval less {interval.first, less_end - array},
+                greater {greater_begin - array, interval.last};
+        auto shorter = less;
+        interval = greater;
+        if (less.size() > greater.size()) std::swap(shorter, interval);
+        if ((shorter.size() > 1) && !queue.push(shorter))
+            sort_interval(array, shorter, comp, queue);
+    }
+    sorter.sort(array + interval.first, array + interval.last, comp);
+}
+
+#endif //QUICKSORT_PROCESS_SORTER_HPP
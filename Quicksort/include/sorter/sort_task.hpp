@@ -0,0 +1,67 @@
+/**
+ * Sorting running in the background thread
+ * with cancellation and progress reporting.
+ */
+
+#ifndef QUICKSORT_SORT_TASK_HPP
+#define QUICKSORT_SORT_TASK_HPP
+
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <future>
+#include <memory>
+#include <stop_token>
+
+#include "sorter/thread_pool.hpp"
+
+// Handle of the sorting started by Sorter::sort_async.
+// The sorting checks the cancellation before each partition,
+// the cancelled array keeps all its elements but is only partly sorted.
+// The progress is the fraction of elements
+// in the finished (sorted by inserts) intervals.
+// The sortings run on the bounded pool of const_sort::async_thread_count
+// threads (not the shared pool of the parallel sorting, so a sorting
+// using it cannot wait for itself), the others wait in its queue.
+// The destructor cancels the unfinished sorting and waits for its end,
+// so the array is not used after the handle is destroyed.
+// Example:
+//      auto task = sorter.sort_async(array, array + size, LESS(int));
+//      while (task.wait_for(std::chrono::milliseconds(10)) !=
+//             std::future_status::ready)
+//          std::cout << task.progress() << std::endl;
+//      bool sorted = task.get();
+class SortTask final {
+public:
+    // The sorting: returns false if it was cancelled by the token,
+    // adds lengths of the finished intervals to the counter.
+    using Job = std::function<bool(std::stop_token, std::atomic<long> &)>;
+private:
+    struct State {
+        std::stop_source source;
+        std::atomic<long> finished{0};
+        ThreadPool::TaskGroup group;
+    };
+    std::shared_ptr<State> state;
+    long total;
+    std::future<bool> result;
+    std::unique_ptr<std::stop_callback<std::function<void()>>> external_stop;
+public:
+    SortTask(Job, long, std::stop_token = {});
+    SortTask(SortTask &&) = default;
+    SortTask &operator =(SortTask &&) = delete;
+    ~SortTask();
+
+    double progress() const;
+    void cancel();
+    bool get();
+    template<typename Rep, typename Period>
+    std::future_status wait_for(
+            const std::chrono::duration<Rep, Period> &timeout) const {
+        return result.wait_for(timeout);
+    }
+private:
+    static ThreadPool &executor();
+};
+
+#endif //QUICKSORT_SORT_TASK_HPP
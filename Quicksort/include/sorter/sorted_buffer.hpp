@@ -0,0 +1,197 @@
+/**
+ * Buffer of template values which are appended continuously
+ * and read in sorted order.
+ */
+
+#ifndef QUICKSORT_SORTED_BUFFER_HPP
+#define QUICKSORT_SORTED_BUFFER_HPP
+
+#include <algorithm>
+#include <functional>
+#include <iterator>
+#include <utility>
+#include <vector>
+
+#include "constants.hpp"
+#include "sorter/merger.hpp"
+#include "sorter/sorter.hpp"
+
+// Buffer that keeps the sorted part as several sorted runs
+// and the unsorted tail of the recently appended values.
+// The tail is sorted by Sorter and becomes a new run
+// when it reaches batch_length or when the buffer is read.
+// Runs of close sizes are merged (like a binary counter),
+// so there are at most log(size / batch_length) runs
+// and each value is merged O(log(size / batch_length)) times,
+// i.e. the cost grows with the number of new values, not with the whole size.
+// The iterator merges the runs lazily during the reading.
+// Example:
+//      auto comp = LESS(int);
+//      SortedBuffer<int, decltype(comp)> buffer(comp);
+//      for (int i = 10; i > 0; --i) buffer.insert(i);
+//      for (auto it = buffer.iterator(); !it.isEnd(); it.next())
+//          std::cout << it.get() << std::endl;
+template<typename T, typename Compare = std::less<T>>
+class SortedBuffer final {
+    std::vector<std::vector<T>> runs;
+    std::vector<T> tail;
+    std::size_t _size;
+    std::size_t batch_length;
+    Compare comp;
+    Sorter sorter;
+
+// Methods
+public:
+    explicit SortedBuffer(Compare comp = Compare(),
+                          std::size_t batch_init_length = const_buffer::batch_len)
+    : _size(0),
+    batch_length(batch_init_length > 0 ? batch_init_length : const_buffer::batch_len),
+    comp(comp) {}
+
+    std::size_t size() const {return _size;}
+    std::size_t runCount() const {return runs.size();}
+
+    void insert(const T &);
+    void flush();
+    std::pair<const T *, const T *> sorted();
+    void clear();
+
+private:
+    void mergeLastRuns();
+
+// Auxiliary Class
+public:
+    // Reads the values of the buffer in sorted order
+    // taking on each step the smallest of the current values of the runs.
+    // The iterator is invalidated by any change of the buffer.
+    class Iterator {
+        std::vector<std::pair<const T *, const T *>> cursors;
+        int current;
+        Compare comp;
+    public:
+        Iterator(const std::vector<std::vector<T>> &runs, Compare comp)
+        : current(-1), comp(comp) {
+            for (const auto &run : runs)
+                if (!run.empty())
+                    cursors.emplace_back(run.data(), run.data() + run.size());
+            findCurrent();
+        }
+
+        const T &get() const {return *cursors[current].first;}
+        bool isEnd() const {return current < 0;}
+        void next();
+    private:
+        void findCurrent();
+    };
+
+    Iterator iterator() {
+        flush();
+        return Iterator(runs, comp);
+    }
+};
+
+/*
+ * INSERT
+ */
+
+// Appends the value to the unsorted tail
+// and sorts the tail when it becomes long enough.
+/// \tparam T - type of values
+/// \tparam Compare - type of predicat
+/// \param value - new value
+template<typename T, typename Compare>
+void SortedBuffer<T, Compare>::insert(const T &value) {
+    tail.push_back(value);
+    _size++;
+    if (tail.size() >= batch_length) flush();
+}
+
+// Sorts the unsorted tail, adds it as a new run
+// and merges the runs while the last run is not shorter
+// than a half of the previous one.
+/// \tparam T - type of values
+/// \tparam Compare - type of predicat
+template<typename T, typename Compare>
+void SortedBuffer<T, Compare>::flush() {
+    if (tail.empty()) return;
+    sorter.sort(tail.data(), tail.data() + tail.size(), comp);
+    runs.push_back(std::move(tail));
+    tail.clear();
+    tail.reserve(batch_length);
+    while ((runs.size() > 1) &&
+           (2 * runs.back().size() >= runs[runs.size() - 2].size()))
+        mergeLastRuns();
+}
+
+// Merges the two last runs into one.
+/// \tparam T - type of values
+/// \tparam Compare - type of predicat
+template<typename T, typename Compare>
+void SortedBuffer<T, Compare>::mergeLastRuns() {
+    auto &first = runs[runs.size() - 2], &second = runs.back();
+    std::vector<T> result;
+    result.reserve(first.size() + second.size());
+    std::merge(std::make_move_iterator(first.begin()),
+               std::make_move_iterator(first.end()),
+               std::make_move_iterator(second.begin()),
+               std::make_move_iterator(second.end()),
+               std::back_inserter(result), comp);
+    runs.pop_back();
+    runs.back() = std::move(result);
+}
+
+// Merges all values into one sorted run with the k-way Merger
+// and returns it.
+/// \tparam T - type of values
+/// \tparam Compare - type of predicat
+/// \return - pointers to the beginning and after the end of the sorted values
+template<typename T, typename Compare>
+std::pair<const T *, const T *> SortedBuffer<T, Compare>::sorted() {
+    flush();
+    if (runs.size() > 1) {
+        std::vector<SortedRun<T>> inputs;
+        for (auto &run : runs)
+            inputs.push_back({run.data(), run.data() + run.size()});
+        std::vector<T> result(_size);
+        Merger().merge(inputs.data(), inputs.data() + inputs.size(),
+                       result.data(), comp);
+        runs.clear();
+        runs.push_back(std::move(result));
+    }
+    if (runs.empty()) return {nullptr, nullptr};
+    return {runs[0].data(), runs[0].data() + runs[0].size()};
+}
+
+// Removes all values from the buffer.
+/// \tparam T - type of values
+/// \tparam Compare - type of predicat
+template<typename T, typename Compare>
+void SortedBuffer<T, Compare>::clear() {
+    runs.clear();
+    tail.clear();
+    _size = 0;
+}
+
+/*
+ * Methods of Iterator
+ */
+
+template<typename T, typename Compare>
+void SortedBuffer<T, Compare>::Iterator::next() {
+    if (isEnd()) return;
+    cursors[current].first++;
+    findCurrent();
+}
+
+// Finds the run with the smallest current value.
+template<typename T, typename Compare>
+void SortedBuffer<T, Compare>::Iterator::findCurrent() {
+    current = -1;
+    for (auto i = 0; i < static_cast<int>(cursors.size()); i++) {
+        if (cursors[i].first == cursors[i].second) continue;
+        if ((current < 0) ||
+            comp(*cursors[i].first, *cursors[current].first)) current = i;
+    }
+}
+
+#endif //QUICKSORT_SORTED_BUFFER_HPP
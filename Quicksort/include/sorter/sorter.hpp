@@ -6,11 +6,92 @@
 #ifndef QUICKSORT_SORTER_HPP
 #define QUICKSORT_SORTER_HPP
 
+#include <algorithm>
 #include <stdexcept>
 #include <iostream>
+#include <iterator>
+#include <limits>
+#include <memory>
+
 #include <stack>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <execution>
+#include <numeric>
+#include <stop_token>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
 
 #include "constants.hpp"
+#include "sorter/cache_info.hpp"
+#include "sorter/float_order.hpp"
+#include "sorter/merger.hpp"
+#include "sorter/sort_task.hpp"
+#include "sorter/thread_pool.hpp"
+
+// Range [min; max] of integer keys known by the caller.
+template<typename T>
+struct KeyRange {
+    T min;
+    T max;
+};
+
+// Cost of one call of the comparison predicate.
+// For expensive predicates (e.g. locale-aware collation of strings)
+// the short intervals are sorted by binary inserts.
+enum class ComparatorCost {
+    cheap,
+    expensive,
+};
+
+// Counters of the work of one sorting (the policy of Sorter::sort
+// that counts the work). The moves are copies and moves of elements,
+// the depth is the level of the interval in the tree of partitions,
+// the partition is unbalanced if its shorter part is
+// less than 1/unbalanced_ratio of the interval.
+// Example:
+//      auto stats = sorter.sort<SortStats>(array, array + size, LESS(int));
+//      std::cout << stats.comparisons << ' ' << stats.insertion_share();
+struct SortStats {
+    long elements = 0;
+    long comparisons = 0;
+    long moves = 0;
+    int max_depth = 0;
+    long unbalanced_partitions = 0;
+    long insertion_elements = 0;
+
+    // part of the elements sorted by inserts in the short intervals
+    double insertion_share() const {
+        return (elements > 0) ?
+               static_cast<double>(insertion_elements) / elements : 0;
+    }
+
+    void sorted(long length) {elements += length;}
+    void compared() {comparisons++;}
+    void moved(long count) {moves += count;}
+    void partitioned(long shorter_length, long length) {
+        if (shorter_length * const_sort::unbalanced_ratio < length)
+            unbalanced_partitions++;
+    }
+    void inserted(long length, int depth) {
+        insertion_elements += length;
+        max_depth = std::max(max_depth, depth);
+    }
+};
+
+// The policy of Sorter::sort without counters (default):
+// the calls are empty and are removed by the compiler.
+struct NoSortStats {
+    void sorted(long) {}
+    void compared() {}
+    void moved(long) {}
+    void partitioned(long, long) {}
+    void inserted(long, int) {}
+};
 
 // Sorting an template array
 // using a combination of recursive and iterative fast sorting algorithms
@@ -19,16 +100,52 @@
 //      int array[] = {7, 4, 1, 5};
 //      Sorter sorter;
 //      sorter.sort(array, array + 4, [](int a, int b) {return a < b;});
+//      sorter.sort(std::execution::par, array, array + 4, LESS(int));
+//      auto stats = sorter.sort<SortStats>(array, array + 4, LESS(int));
 class Sorter {
     // insert_len is default
     // the class TimeMeter can help you choose length
     int short_interval_max_length;
+    // check whether the array consists of few sorted runs before sorting
+    bool detect_runs;
+    // find the place of inserting by binary search
+    bool binary_leaves;
 public:
+    // set_comparator_cost and calibrate replace the length given here
+    // by insert_len or binary_insert_len
     explicit Sorter(int short_interval_init_length =
-            const_sort::insert_len)
-    : short_interval_max_length(short_interval_init_length) {}
+            const_sort::insert_len, bool detect_runs_init = true)
+    : short_interval_max_length(short_interval_init_length),
+    detect_runs(detect_runs_init), binary_leaves(false) {}
 
-    template<typename T, typename Compare> void sort(T *, T *, Compare);
+    void set_comparator_cost(ComparatorCost);
+    template<typename Clock = std::chrono::steady_clock, typename T,
+             typename Compare>
+        ComparatorCost calibrate(T *, T *, Compare);
+
+    template<typename Stats = NoSortStats, typename T, typename Compare>
+        Stats sort(T *, T *, Compare);
+    template<typename ExecutionPolicy, typename T, typename Compare>
+        requires std::is_execution_policy_v<std::remove_cvref_t<ExecutionPolicy>>
+        void sort(ExecutionPolicy &&, T *, T *, Compare);
+    template<typename T, typename Compare>
+        SortTask sort_async(T *, T *, Compare, std::stop_token = {});
+    template<typename T> void sort_total_order(T *, T *, bool = true);
+    template<typename K, typename Compare, typename... Payloads>
+        void sort_columns(K *, K *, Compare, Payloads *...);
+    template<typename T, typename Compare>
+        void sort_cache_tiled(T *, T *, Compare, long = 0);
+    template<typename T> requires std::is_integral_v<T>
+        void sort_small_range(T *, T *);
+    template<typename T> requires std::is_integral_v<T>
+        void sort_small_range(T *, T *, KeyRange<T>);
+    template<typename K, typename V> requires std::is_integral_v<K>
+        void sort_small_range_by_key(K *, K *, V *);
+    template<typename K, typename V> requires std::is_integral_v<K>
+        void sort_small_range_by_key(K *, K *, V *, KeyRange<K>);
+    template<typename T, typename Compare> T *sort_unique(T *, T *, Compare);
+    template<typename K, typename V, typename Compare, typename Reduce>
+        K *sort_reduce_by_key(K *, K *, V *, Compare, Reduce);
     template<typename T> void print(T *, T *) const;
 
     //Selection
@@ -36,36 +153,535 @@ public:
     template<typename T, typename Compare> void simple_insertion_sort(T *, T *, Compare);
 private:
 
-    template<typename T, typename Compare> void quicksort(T *, T *, Compare);
+    template<typename T, typename Compare, typename Stats>
+        bool sort_runs(T *, T *, Compare, Stats &);
+    template<typename T, typename Compare, typename Stats = NoSortStats>
+        void quicksort(T *, T *, Compare, Stats && = {}, int = 0);
+    template<typename T, typename Compare>
+        void parallel_quicksort(T *, T *, Compare, ThreadPool::TaskGroup *,
+                                bool);
     template<typename T, typename Compare>
-        void insertion_sort(T *, T *, Compare);
+        bool cancellable_quicksort(T *, T *, Compare, const std::stop_token &,
+                                   std::atomic<long> &);
+    template<typename T, typename Compare, typename Stats = NoSortStats>
+        void insertion_sort(T *, T *, Compare, Stats && = {});
+    template<typename T, typename Compare, typename Stats>
+        void binary_insertion_sort(T *, T *, Compare, Stats &);
+    template<typename T, typename Compare, typename Fold>
+        T *unique_sort(T *, T *, Compare, Fold);
+    template<typename T, typename Compare, typename Fold>
+        T *unique_leaf(T *, T *, Compare, Fold);
 
     template<typename T, typename Compare> T select_pivot(T *, T *, Compare);
+    template<typename T, typename Compare, typename Stats = NoSortStats>
+        T *partition(T *&, T *&, T, Compare comp, Stats && = {});
     template<typename T, typename Compare>
-        T *partition(T *&, T *&, T, Compare comp);
+        T *branchless_partition(T *, T *, Compare comp);
+
+    template<typename Key> void radix_sort(Key *, Key *, Key *);
+    template<typename P> void permute(P *, const std::vector<long> &, std::vector<P> &);
+    template<typename T> bool find_small_range(T *, T *, KeyRange<T> &);
+    template<typename T> std::uint64_t range_length(KeyRange<T>);
+    template<typename T> std::vector<std::vector<long>>
+        histograms(T *, T *, KeyRange<T>);
+    template<typename T> void counting_sort(T *, T *, KeyRange<T>);
+    template<typename K, typename V>
+        void counting_sort_by_key(K *, K *, V *, KeyRange<K>);
 
+    template<typename Compare, typename Stats>
+        static auto counting(Compare, Stats &);
     template<typename T> void swap(T *, T *);
 };
 
+// The function chooses the sorting of short intervals:
+// inserts with the linear search of the place and insert_len
+// for cheap predicates, with the binary search and binary_insert_len
+// for expensive ones (the length given to the constructor is replaced).
+/// \param cost - cost of the comparison predicate
+inline void Sorter::set_comparator_cost(ComparatorCost cost) {
+    binary_leaves = (cost == ComparatorCost::expensive);
+    short_interval_max_length = binary_leaves ?
+            const_sort::binary_insert_len : const_sort::insert_len;
+}
+
+// The function sorts copies of the sample by leaves of binary_insert_len
+// elements with the linear and with the binary search of the place,
+// and sets the comparator cost: the predicate is expensive
+// if the binary inserts are faster (the best of calibration_rounds).
+// As set_comparator_cost, it replaces the length given to the constructor.
+/// \tparam Clock - clock for measuring (steady_clock, a fake clock in tests)
+/// \tparam T - type of array elements
+/// \tparam Compare - type of predicat
+/// \param first - pointer to the beginning of the sample array
+/// \param last - pointer to an element after the end of the sample array
+/// \param comp - the comparison predicate for the specified types
+/// \return - the chosen cost
+template<typename Clock, typename T, typename Compare>
+ComparatorCost Sorter::calibrate(T *first, T *last, Compare comp) {
+    auto cost = ComparatorCost::cheap;
+    auto length = std::min<long>(last - first, const_sort::calibration_len);
+    if (length >= 2) {
+        auto leaf_length = std::min<long>(length, const_sort::binary_insert_len);
+        auto sample_length = length - length % leaf_length;
+        auto time_leaves = [=, this](bool binary) {
+            std::vector<T> sample(first, first + sample_length);
+            NoSortStats stats;
+            auto start = Clock::now();
+            for (auto leaf = sample.data(); leaf < sample.data() + sample_length;
+                 leaf += leaf_length) {
+                if (binary)
+                    binary_insertion_sort(leaf, leaf + leaf_length - 1, comp, stats);
+                else simple_insertion_sort(leaf, leaf + leaf_length - 1, comp);
+            }
+            return Clock::now() - start;
+        };
+        auto linear_time = Clock::duration::max();
+        auto binary_time = linear_time;
+        for (auto round = 0; round < const_sort::calibration_rounds; round++) {
+            linear_time = std::min(linear_time, time_leaves(false));
+            binary_time = std::min(binary_time, time_leaves(true));
+        }
+        if (binary_time < linear_time) cost = ComparatorCost::expensive;
+    }
+    set_comparator_cost(cost);
+    return cost;
+}
+
 // The function sends the array to the appropriate sorting for it:
-// quick sort or insertion sort.
+// merging of few sorted runs, quick sort or insertion sort.
+// With the policy SortStats the work of the sorting is counted.
+/// \tparam Stats - SortStats - count the work, NoSortStats - without counters
+/// \tparam T - type of array elements
+/// \tparam Compare - type of predicat
+/// \param first - pointer to the beginning of the array
+/// \param last - pointer to an element after the end of the array
+/// \param comp - the comparison predicate for the specified types
+/// \return - the counters of the sorting
+template<typename Stats, typename T, typename Compare>
+Stats Sorter::sort(T *first, T *last, Compare comp) {
+    Stats stats;
+    try {
+        stats.sorted(last - first);
+        if ((last - first) <= 1) return stats;
+        auto counted_comp = counting(comp, stats);
+        if (detect_runs && ((last - first) >= const_sort::presorted_min_len) &&
+            sort_runs(first, last, counted_comp, stats))
+            return stats;
+        last--;
+        quicksort(first, last, counted_comp, stats);
+    }
+    catch(std::exception &ex) {
+        std::cerr << UNEXPECTED_MES << ex.what() << std::endl;
+    }
+    return stats;
+}
+
+// The function sorts the array with the execution policy:
+// seq - in the current thread as sort(first, last, comp),
+// unseq - in the current thread with the branchless partition
+// for arithmetic types,
+// par - intervals after partitions are sorted by the threads of the pool,
+// par_unseq - as par with the branchless partition for arithmetic types.
+/// \tparam ExecutionPolicy - type of std::execution policy
 /// \tparam T - type of array elements
 /// \tparam Compare - type of predicat
 /// \param first - pointer to the beginning of the array
 /// \param last - pointer to an element after the end of the array
 /// \param comp - the comparison predicate for the specified types
+template<typename ExecutionPolicy, typename T, typename Compare>
+    requires std::is_execution_policy_v<std::remove_cvref_t<ExecutionPolicy>>
+void Sorter::sort(ExecutionPolicy &&, T *first, T *last, Compare comp) {
+    using Policy = std::remove_cvref_t<ExecutionPolicy>;
+    constexpr auto unsequenced =
+            std::is_same_v<Policy, std::execution::parallel_unsequenced_policy> ||
+            std::is_same_v<Policy, std::execution::unsequenced_policy>;
+    constexpr auto parallel =
+            std::is_same_v<Policy, std::execution::parallel_policy> ||
+            std::is_same_v<Policy, std::execution::parallel_unsequenced_policy>;
+    if constexpr (!parallel && !unsequenced) sort(first, last, comp);
+    else try {
+        if ((last - first) <= 1) return;
+        if constexpr (parallel) {
+            ThreadPool::TaskGroup group;
+            parallel_quicksort(first, last - 1, comp, &group, unsequenced);
+            group.wait();
+        }
+        else parallel_quicksort(first, last - 1, comp, nullptr, unsequenced);
+    }
+    catch(std::exception &ex) {
+        std::cerr << UNEXPECTED_MES << ex.what() << std::endl;
+    }
+}
+
+// The function starts sorting the array in the background thread.
+// The array must not be used until the sorting is finished
+// or the returned task is destroyed.
+/// \tparam T - type of array elements
+/// \tparam Compare - type of predicat
+/// \param first - pointer to the beginning of the array
+/// \param last - pointer to an element after the end of the array
+/// \param comp - the comparison predicate for the specified types
+/// \param token - token for cancellation of the sorting
+/// \return - the task with the result, the progress and the cancellation
 template<typename T, typename Compare>
-void Sorter::sort(T *first, T *last, Compare comp) {
+SortTask Sorter::sort_async(T *first, T *last, Compare comp,
+                            std::stop_token token) {
+    auto sorter = *this;
+    return SortTask([=](std::stop_token stop,
+                        std::atomic<long> &finished) mutable {
+        if ((last - first) <= 1) {
+            finished += last - first;
+            return true;
+        }
+        return sorter.cancellable_quicksort(first, last - 1, comp,
+                                            stop, finished);
+    }, last - first, token);
+}
+
+// The function sorts the array of floating-point numbers
+// in the total order: -inf < ... < -0.0 < +0.0 < ... < +inf,
+// NaNs are placed at the end (-NaN before +NaN) or, if nans_last is false,
+// at the ends as in IEEE 754 totalOrder (-NaN first, +NaN last).
+// The numbers are mapped to unsigned integer keys
+// which are sorted by the radix sort (by the quicksort for short arrays).
+/// \tparam T - float or double
+/// \param first - pointer to the beginning of the array
+/// \param last - pointer to an element after the end of the array
+/// \param nans_last - place all NaNs at the end of the array
+template<typename T>
+void Sorter::sort_total_order(T *first, T *last, bool nans_last) {
     try {
         if ((last - first) <= 1) return;
-        last--;
-        quicksort(first, last, comp);
+        using Key = float_key_t<T>;
+        auto length = last - first;
+        std::vector<Key> keys(length);
+        for (long i = 0; i < length; i++) keys[i] = total_order_key(first[i]);
+        if (length < const_sort::radix_len)
+            quicksort(keys.data(), keys.data() + length - 1, LESS(Key));
+        else {
+            std::vector<Key> buffer(length);
+            radix_sort(keys.data(), keys.data() + length, buffer.data());
+        }
+        for (long i = 0; i < length; i++)
+            first[i] = from_total_order_key<T>(keys[i]);
+        if (!nans_last) return;
+        auto numbers = std::find_if_not(first, last,
+                                        [](T a) {return std::isnan(a);});
+        auto positive_nans = std::find_if(numbers, last,
+                                          [](T a) {return std::isnan(a);});
+        std::rotate(first, numbers, positive_nans);
+    }
+    catch(std::exception &ex) {
+        std::cerr << UNEXPECTED_MES << ex.what() << std::endl;
+    }
+}
+
+// The function sorts the column of keys
+// and applies the same permutation to the columns of payloads,
+// so the rows (key and payloads with the same index) stay together.
+// The permutation is found by sorting the row indices comparing their keys,
+// then the buffers for all columns are allocated
+// and each column is gathered into its buffer
+// by the sequential pass over the permutation and moved back.
+// So an exception of the predicate or of the allocation
+// leaves all columns unchanged (the moves of elements must not throw).
+// Example:
+//      int keys[] = {3, 1, 2};
+//      double prices[] = {0.3, 0.1, 0.2};
+//      std::string names[] = {"c", "a", "b"};
+//      sorter.sort_columns(keys, keys + 3, LESS(int), prices, names);
+/// \tparam K - type of keys
+/// \tparam Compare - type of predicat
+/// \tparam Payloads - types of payloads
+/// \param first - pointer to the beginning of the column of keys
+/// \param last - pointer to an element after the end of the column of keys
+/// \param comp - the comparison predicate for keys
+/// \param payloads - pointers to the beginnings of the payload columns
+/// with the same length as keys
+template<typename K, typename Compare, typename... Payloads>
+void Sorter::sort_columns(K *first, K *last, Compare comp,
+                          Payloads *... payloads) {
+    try {
+        if ((last - first) <= 1) return;
+        if (((payloads == nullptr) || ...))
+            throw std::invalid_argument(ILLEGAL_ARG_ARRAY_EXC_MESSAGE);
+        auto length = last - first;
+        std::vector<long> permutation(length);
+        std::iota(permutation.begin(), permutation.end(), 0L);
+        quicksort(permutation.data(), permutation.data() + length - 1,
+                  [&comp, first](long a, long b) {return comp(first[a], first[b]);});
+        std::tuple<std::vector<K>, std::vector<Payloads>...> buffers;
+        std::apply([length](auto &... buffer) {(buffer.reserve(length), ...);},
+                   buffers);
+        std::apply([&](auto &keys, auto &... columns) {
+            permute(first, permutation, keys);
+            (permute(payloads, permutation, columns), ...);
+        }, buffers);
+    }
+    catch(std::exception &ex) {
+        std::cerr << UNEXPECTED_MES << ex.what() << std::endl;
+    }
+}
+
+// The function sorts the array which is much larger than the cache:
+// blocks of half of the L2 cache are sorted by quicksort
+// (each block is read from memory once and stays in the cache),
+// then the blocks are merged by Merger with at most merge_fan_in inputs
+// at a time, so every pass of merging streams the array once.
+// Trivially copyable elements are merged into uninitialized scratch space,
+// other elements are moved to the buffer and merged back from it.
+// The size of L2 is read from sysfs once (l2_size_default if it is unknown).
+/// \tparam T - type of array elements
+/// \tparam Compare - type of predicat
+/// \param first - pointer to the beginning of the array
+/// \param last - pointer to an element after the end of the array
+/// \param comp - the comparison predicate for the specified types
+/// \param block_length - number of elements in a block (0 - by the cache)
+template<typename T, typename Compare>
+void Sorter::sort_cache_tiled(T *first, T *last, Compare comp, long block_length) {
+    try {
+        auto length = last - first;
+        if (length <= 1) return;
+        if (block_length <= 0)
+            block_length = std::max<long>(
+                    static_cast<long>(cache_block_size() / sizeof(T)),
+                    4 * (short_interval_max_length + 1));
+        if (length <= block_length) {
+            quicksort(first, last - 1, comp);
+            return;
+        }
+        std::vector<SortedRun<T>> runs;
+        for (auto block = first; block < last; block += block_length) {
+            auto block_last = std::min(block + block_length, last);
+            quicksort(block, block_last - 1, comp);
+            runs.push_back({block, block_last});
+        }
+        std::unique_ptr<T[]> scratch;
+        std::vector<T> buffer;
+        auto source = first, target = first;
+        if constexpr (std::is_trivially_copyable_v<T> &&
+                      std::is_default_constructible_v<T>) {
+            scratch = std::make_unique_for_overwrite<T[]>(length);
+            target = scratch.get();
+        }
+        else {
+            buffer.assign(std::make_move_iterator(first),
+                          std::make_move_iterator(last));
+            for (auto &run : runs) {
+                run.first = buffer.data() + (run.first - first);
+                run.last = buffer.data() + (run.last - first);
+            }
+            source = buffer.data();
+        }
+        Merger merger;
+        while (runs.size() > 1) {
+            std::vector<SortedRun<T>> merged;
+            for (std::size_t group = 0; group < runs.size();
+                 group += const_sort::merge_fan_in) {
+                auto group_last = std::min(group + const_sort::merge_fan_in,
+                                           runs.size());
+                auto out = target + (runs[group].first - source);
+                merger.merge(runs.data() + group, runs.data() + group_last,
+                             out, comp);
+                merged.push_back({out, out + (runs[group_last - 1].last -
+                                              runs[group].first)});
+            }
+            runs = std::move(merged);
+            std::swap(source, target);
+        }
+        if (source != first) std::move(source, source + length, first);
+    }
+    catch(std::exception &ex) {
+        std::cerr << UNEXPECTED_MES << ex.what() << std::endl;
+    }
+}
+
+// The function sorts integers in ascending order by counting
+// if the range of values is small (not longer than
+// the doubled length of the array and counting_max_range),
+// and by quicksort otherwise.
+// The range is estimated by the sample of counting_sample_len elements
+// and checked by the full pass only if the estimate is small.
+/// \tparam T - integer type
+/// \param first - pointer to the beginning of the array
+/// \param last - pointer to an element after the end of the array
+template<typename T> requires std::is_integral_v<T>
+void Sorter::sort_small_range(T *first, T *last) {
+    try {
+        if ((last - first) <= 1) return;
+        KeyRange<T> range;
+        if (find_small_range(first, last, range))
+            counting_sort(first, last, range);
+        else quicksort(first, last - 1, LESS(T));
+    }
+    catch(std::exception &ex) {
+        std::cerr << UNEXPECTED_MES << ex.what() << std::endl;
+    }
+}
+
+// The function sorts integers in ascending order by counting
+// with the range given by the caller.
+/// \tparam T - integer type
+/// \param first - pointer to the beginning of the array
+/// \param last - pointer to an element after the end of the array
+/// \param range - all values are in [range.min; range.max]
+template<typename T> requires std::is_integral_v<T>
+void Sorter::sort_small_range(T *first, T *last, KeyRange<T> range) {
+    try {
+        if ((last - first) <= 1) return;
+        if ((range.max < range.min) ||
+            (range_length(range) > const_sort::counting_max_range))
+            throw std::invalid_argument(ILLEGAL_ARG_RANGE_EXC_MESSAGE);
+        counting_sort(first, last, range);
     }
     catch(std::exception &ex) {
         std::cerr << UNEXPECTED_MES << ex.what() << std::endl;
     }
 }
 
+// The function sorts integer keys in ascending order
+// and moves the values with them.
+// The sorting is stable: values with equal keys keep their order.
+// Small range of keys is sorted by counting,
+// otherwise by std::stable_sort of pairs.
+/// \tparam K - integer type of keys
+/// \tparam V - type of values
+/// \param first - pointer to the beginning of the keys
+/// \param last - pointer to an element after the end of the keys
+/// \param values - pointer to the beginning of the values
+template<typename K, typename V> requires std::is_integral_v<K>
+void Sorter::sort_small_range_by_key(K *first, K *last, V *values) {
+    try {
+        if ((last - first) <= 1) return;
+        KeyRange<K> range;
+        if (find_small_range(first, last, range)) {
+            counting_sort_by_key(first, last, values, range);
+            return;
+        }
+        auto length = last - first;
+        std::vector<std::pair<K, V>> pairs;
+        pairs.reserve(length);
+        for (long i = 0; i < length; i++)
+            pairs.emplace_back(first[i], std::move(values[i]));
+        std::stable_sort(pairs.begin(), pairs.end(),
+                         [](const std::pair<K, V> &a, const std::pair<K, V> &b) {
+            return a.first < b.first;
+        });
+        for (long i = 0; i < length; i++) {
+            first[i] = pairs[i].first;
+            values[i] = std::move(pairs[i].second);
+        }
+    }
+    catch(std::exception &ex) {
+        std::cerr << UNEXPECTED_MES << ex.what() << std::endl;
+    }
+}
+
+// The function sorts integer keys stably by counting
+// with the range given by the caller and moves the values with them.
+/// \tparam K - integer type of keys
+/// \tparam V - type of values
+/// \param first - pointer to the beginning of the keys
+/// \param last - pointer to an element after the end of the keys
+/// \param values - pointer to the beginning of the values
+/// \param range - all keys are in [range.min; range.max]
+template<typename K, typename V> requires std::is_integral_v<K>
+void Sorter::sort_small_range_by_key(K *first, K *last, V *values,
+                                     KeyRange<K> range) {
+    try {
+        if ((last - first) <= 1) return;
+        if ((range.max < range.min) ||
+            (range_length(range) > const_sort::counting_max_range))
+            throw std::invalid_argument(ILLEGAL_ARG_RANGE_EXC_MESSAGE);
+        counting_sort_by_key(first, last, values, range);
+    }
+    catch(std::exception &ex) {
+        std::cerr << UNEXPECTED_MES << ex.what() << std::endl;
+    }
+}
+
+// The function sorts the array and leaves one element
+// of each group of equal elements (the others are removed
+// in the partitions and in the leaves, not by a separate pass).
+// Elements after the returned end have unspecified values.
+// If the predicate throws, the error is printed and first is returned:
+// the elements of the array stay valid, but their values are unspecified
+// (some of them can be moved to other places).
+// Example:
+//      int array[] = {3, 1, 3, 2, 1};
+//      auto end = sorter.sort_unique(array, array + 5, LESS(int));
+//      // array: 1 2 3, end == array + 3
+/// \tparam T - type of array elements
+/// \tparam Compare - type of predicat
+/// \param first - pointer to the beginning of the array
+/// \param last - pointer to an element after the end of the array
+/// \param comp - the comparison predicate for the specified types
+/// \return - pointer to an element after the end of the unique elements
+template<typename T, typename Compare>
+T *Sorter::sort_unique(T *first, T *last, Compare comp) {
+    try {
+        return unique_sort(first, last, comp, [](T &, T &) {});
+    }
+    catch(std::exception &ex) {
+        std::cerr << UNEXPECTED_MES << ex.what() << std::endl;
+    }
+    return first;
+}
+
+// The function sorts the keys, moves the values with them
+// and leaves one key of each group of equal keys
+// with the value combined from the values of the group by reduce.
+// The order of combining is not specified,
+// so reduce should be associative and commutative (sum, min, max).
+// If the predicate or reduce throws, the error is printed and first is returned:
+// the keys and the values stay valid, but their values are unspecified.
+// Example:
+//      int keys[] = {2, 1, 2};
+//      int counts[] = {1, 1, 1};
+//      auto end = sorter.sort_reduce_by_key(keys, keys + 3, counts, LESS(int),
+//                                           [](int a, int b) {return a + b;});
+//      // keys: 1 2, counts: 1 2, end == keys + 2
+/// \tparam K - type of keys
+/// \tparam V - type of values
+/// \tparam Compare - type of predicat
+/// \tparam Reduce - type of the function combining two values
+/// \param first - pointer to the beginning of the keys
+/// \param last - pointer to an element after the end of the keys
+/// \param values - pointer to the beginning of the values
+/// \param comp - the comparison predicate for keys
+/// \param reduce - the function combining two values into one
+/// \return - pointer to an element after the end of the unique keys
+template<typename K, typename V, typename Compare, typename Reduce>
+K *Sorter::sort_reduce_by_key(K *first, K *last, V *values, Compare comp,
+                              Reduce reduce) {
+    try {
+        if ((last - first) <= 0) return last;
+        auto length = last - first;
+        std::vector<std::pair<K, V>> pairs;
+        pairs.reserve(length);
+        for (long i = 0; i < length; i++)
+            pairs.emplace_back(std::move(first[i]), std::move(values[i]));
+        auto end = unique_sort(
+                pairs.data(), pairs.data() + length,
+                [&comp](const std::pair<K, V> &a, const std::pair<K, V> &b) {
+                    return comp(a.first, b.first);
+                },
+                [&reduce](std::pair<K, V> &kept, std::pair<K, V> &removed) {
+                    kept.second = reduce(kept.second, removed.second);
+                });
+        auto unique_length = end - pairs.data();
+        for (long i = 0; i < unique_length; i++) {
+            first[i] = std::move(pairs[i].first);
+            values[i] = std::move(pairs[i].second);
+        }
+        return first + unique_length;
+    }
+    catch(std::exception &ex) {
+        std::cerr << UNEXPECTED_MES << ex.what() << std::endl;
+    }
+    return first;
+}
+
 // The function that prints an array
 /// \tparam T - type of array elements
 /// \param first - pointer to the beginning of the array
@@ -77,6 +693,57 @@ void Sorter::print(T *first, T *last) const {
     std::cout << std::endl;
 }
 
+// The function divides the array into sorted runs by one pass,
+// non-increasing runs are reversed in place.
+// The scan stops when there are more than presorted_max_runs runs.
+// A single run is the sorted array,
+// several runs are moved to the buffer and merged back by Merger.
+// Merger reads the inputs by copies of their blocks and does not change them,
+// so if the predicate throws, the elements are moved back from the buffer
+// (the array keeps all elements in the order of the runs).
+/// \tparam T - type of array elements
+/// \tparam Compare - type of predicat
+/// \param first - pointer to the beginning of the array
+/// \param last - pointer to an element after the end of the array
+/// \param comp - the comparison predicate for the specified types
+/// \param stats - the counters of the sorting
+/// \return - the array is sorted (true) or it needs quicksort (false)
+template<typename T, typename Compare, typename Stats>
+bool Sorter::sort_runs(T *first, T *last, const Compare comp, Stats &stats) {
+    std::vector<SortedRun<T>> runs;
+    for (auto begin = first; begin < last; ) {
+        auto end = begin + 1;
+        while ((end < last) &&
+               !comp(*end, *(end - 1)) && !comp(*(end - 1), *end))
+            end++;
+        if ((end < last) && comp(*end, *(end - 1))) {
+            while ((end < last) && !comp(*(end - 1), *end)) end++;
+            std::reverse(begin, end);
+            stats.moved(3 * ((end - begin) / 2));
+        }
+        else while ((end < last) && !comp(*end, *(end - 1))) end++;
+        if (runs.size() == const_sort::presorted_max_runs) return false;
+        runs.push_back({begin, end});
+        begin = end;
+    }
+    if (runs.size() == 1) return true;
+    std::vector<T> buffer(std::make_move_iterator(first),
+                          std::make_move_iterator(last));
+    for (auto &run : runs) {
+        run.first = buffer.data() + (run.first - first);
+        run.last = buffer.data() + (run.last - first);
+    }
+    try {
+        Merger().merge(runs.data(), runs.data() + runs.size(), first, comp);
+    }
+    catch (...) {
+        std::move(buffer.begin(), buffer.end(), first);
+        throw;
+    }
+    stats.moved(2 * (last - first));
+    return true;
+}
+
 // The function sends the array to the first step of quick sort processing
 // with the selected pivot,
 // divides the array depending on the length of the resulting intervals,
@@ -88,22 +755,119 @@ void Sorter::print(T *first, T *last) const {
 /// \param first - pointer to the beginning of the array
 /// \param last - pointer to the last element of the array
 /// \param comp - the comparison predicate for the specified types
+/// \param stats - the counters of the sorting
+/// \param depth - level of the interval in the tree of partitions
+template<typename T, typename Compare, typename Stats>
+void Sorter::quicksort(T *first, T *last, const Compare comp, Stats &&stats,
+                       int depth) {
+    while ((last - first) > short_interval_max_length) {
+        stats.moved(1);
+        auto border = partition(first, last,
+                                select_pivot(first, last, comp), comp, stats);
+        auto first_length = border - first, second_length = last - (border + 1);
+        stats.partitioned(std::min(first_length, second_length) + 1,
+                          last - first + 1);
+        depth++;
+        if (first_length <= second_length) {
+            quicksort(first, border, comp, stats, depth);
+            first = border + 1;
+        }
+        else {
+            quicksort(border + 1, last, comp, stats, depth);
+            last = border;
+        }
+    }
+    stats.inserted(last - first + 1, depth);
+    insertion_sort(first, last, comp, stats);
+}
+
+// The function partitions the array as quicksort,
+// but sends the shorter interval to the threads of the pool
+// while it is long enough, and sorts the rest in the current thread.
+/// \tparam T - type of array elements
+/// \tparam Compare - type of predicat
+/// \param first - pointer to the beginning of the array
+/// \param last - pointer to the last element of the array
+/// \param comp - the comparison predicate for the specified types
+/// \param group - group of the tasks of this sorting,
+/// nullptr - sort in the current thread only
+/// \param unsequenced - use the branchless partition for arithmetic types
 template<typename T, typename Compare>
-void Sorter::quicksort(T *first, T *last, const Compare comp) {
+void Sorter::parallel_quicksort(T *first, T *last, const Compare comp,
+                                ThreadPool::TaskGroup *group,
+                                const bool unsequenced) {
+    auto branchless = unsequenced && std::is_arithmetic_v<T>;
     while ((last - first) > short_interval_max_length) {
+        T *left, *right;
+        if (branchless) {
+            auto border = branchless_partition(first, last, comp);
+            left = border - 1;
+            right = border + 1;
+            // Lomuto scheme is quadratic on many equal elements
+            if ((std::min(border - first, last - border) * 8) < (last - first))
+                branchless = false;
+        }
+        else {
+            auto border = partition(first, last,
+                                    select_pivot(first, last, comp), comp);
+            left = border;
+            right = border + 1;
+        }
+        auto shorter_first = first, shorter_last = left;
+        if ((left - first) <= (last - right)) first = right;
+        else {
+            shorter_first = right;
+            shorter_last = last;
+            last = left;
+        }
+        if ((group != nullptr) &&
+            ((shorter_last - shorter_first) >= const_sort::parallel_len))
+            ThreadPool::shared().submit(*group, [=, this]() {
+                parallel_quicksort(shorter_first, shorter_last, comp,
+                                   group, unsequenced);
+            });
+        else if (branchless)
+            parallel_quicksort(shorter_first, shorter_last, comp,
+                               group, unsequenced);
+        else quicksort(shorter_first, shorter_last, comp);
+    }
+    insertion_sort(first, last, comp);
+}
+
+// The function sorts the array as quicksort,
+// but checks the cancellation before each partition
+// and counts the elements of the intervals sorted by inserts.
+/// \tparam T - type of array elements
+/// \tparam Compare - type of predicat
+/// \param first - pointer to the beginning of the array
+/// \param last - pointer to the last element of the array
+/// \param comp - the comparison predicate for the specified types
+/// \param token - token for cancellation of the sorting
+/// \param finished - number of elements in the finished intervals
+/// \return - the array is sorted (true) or the sorting was cancelled (false)
+template<typename T, typename Compare>
+bool Sorter::cancellable_quicksort(T *first, T *last, const Compare comp,
+                                   const std::stop_token &token,
+                                   std::atomic<long> &finished) {
+    while ((last - first) > short_interval_max_length) {
+        if (token.stop_requested()) return false;
         auto border = partition(first, last,
                                 select_pivot(first, last, comp), comp);
         auto first_length = border - first, second_length = last - (border + 1);
         if (first_length <= second_length) {
-            quicksort(first, border, comp);
+            if (!cancellable_quicksort(first, border, comp, token, finished))
+                return false;
             first = border + 1;
         }
         else {
-            quicksort(border + 1, last, comp);
+            if (!cancellable_quicksort(border + 1, last, comp, token, finished))
+                return false;
             last = border;
         }
     }
     insertion_sort(first, last, comp);
+    finished += last - first + 1;
+    return true;
 }
 
 // The function sorts the array by inserts
@@ -112,8 +876,14 @@ void Sorter::quicksort(T *first, T *last, const Compare comp) {
 /// \param first - pointer to the beginning of the array
 /// \param last - pointer to the last element of the array
 /// \param comp - the comparison predicate for the specified types
-template<typename T, typename Compare>
-void Sorter::insertion_sort(T *first, T *last, const Compare comp) {
+/// \param stats - the counters of the sorting
+template<typename T, typename Compare, typename Stats>
+void Sorter::insertion_sort(T *first, T *last, const Compare comp,
+                            Stats &&stats) {
+    if (binary_leaves) {
+        binary_insertion_sort(first, last, comp, stats);
+        return;
+    }
     for (auto right = first + 1; right <= last; right++) {
         T element = *right;
         T *current = right;
@@ -122,6 +892,116 @@ void Sorter::insertion_sort(T *first, T *last, const Compare comp) {
             current--;
         }
         *current = element;
+        stats.moved(2 + (right - current));
+    }
+}
+
+// The function sorts the array as quicksort with the partition
+// into three parts: less than the pivot, equal and greater.
+// The equal elements are folded into one at once,
+// the short intervals are sorted by inserts and equal neighbours are folded.
+// The intervals are processed from left to right
+// (the pivots and the greater parts wait on the stack),
+// so the unique parts appear in the order of the array
+// and each of them is moved to the end of the kept elements at once.
+/// \tparam T - type of array elements
+/// \tparam Compare - type of predicat
+/// \tparam Fold - type of the function adding the removed element
+/// to the kept one
+/// \param first - pointer to the beginning of the array
+/// \param last - pointer to an element after the end of the array
+/// \param comp - the comparison predicate for the specified types
+/// \param fold - the function adding the removed element to the kept one
+/// \return - pointer to an element after the end of the unique elements
+template<typename T, typename Compare, typename Fold>
+T *Sorter::unique_sort(T *first, T *last, const Compare comp, Fold fold) {
+    if ((last - first) <= 1) return last;
+    // [first; last] is sorted (unique) or is waiting for sorting
+    struct Interval {
+        T *first, *last;
+        bool unique;
+    };
+    auto end = first;
+    auto keep = [&end](T *begin, T *part_last) {
+        if (begin != end) std::move(begin, part_last + 1, end);
+        end += part_last + 1 - begin;
+    };
+    std::vector<Interval> waiting {{first, last - 1, false}};
+    while (!waiting.empty()) {
+        auto interval = waiting.back();
+        waiting.pop_back();
+        if (interval.unique) {
+            keep(interval.first, interval.last);
+            continue;
+        }
+        auto left = interval.first, right = interval.last;
+        auto is_leaf = true;
+        while ((right - left) > short_interval_max_length) {
+            const T pivot = select_pivot(left, right, comp);
+            auto less_end = left, current = left, greater_begin = right;
+            while (current <= greater_begin) {
+                if (comp(*current, pivot)) swap(less_end++, current++);
+                else if (comp(pivot, *current)) swap(current, greater_begin--);
+                else current++;
+            }
+            for (auto equal = less_end + 1; equal <= greater_begin; equal++)
+                fold(*less_end, *equal);
+            if (greater_begin < right)
+                waiting.push_back({greater_begin + 1, right, false});
+            waiting.push_back({less_end, less_end, true});
+            if (less_end == left) {
+                is_leaf = false;
+                break;
+            }
+            right = less_end - 1;
+        }
+        if (is_leaf) keep(left, unique_leaf(left, right, comp, fold));
+    }
+    return end;
+}
+
+// The function sorts the short interval by inserts
+// and folds the equal neighbours moving the unique elements to the left.
+/// \tparam T - type of array elements
+/// \tparam Compare - type of predicat
+/// \tparam Fold - type of the function adding the removed element
+/// to the kept one
+/// \param first - pointer to the beginning of the interval
+/// \param last - pointer to the last element of the interval
+/// \param comp - the comparison predicate for the specified types
+/// \param fold - the function adding the removed element to the kept one
+/// \return - pointer to the last unique element
+template<typename T, typename Compare, typename Fold>
+T *Sorter::unique_leaf(T *first, T *last, const Compare comp, Fold fold) {
+    insertion_sort(first, last, comp);
+    auto end = first;
+    for (auto current = first + 1; current <= last; current++) {
+        if (!comp(*end, *current)) fold(*end, *current);
+        else if (++end != current) *end = std::move(*current);
+    }
+    return end;
+}
+
+// The function sorts the array by inserts,
+// the place of inserting is found by binary search
+// (O(k log k) calls of the predicate instead of O(k^2))
+// and the greater elements are moved by one shift.
+/// \tparam T - type of array elements
+/// \tparam Compare - type of predicat
+/// \param first - pointer to the beginning of the array
+/// \param last - pointer to the last element of the array
+/// \param comp - the comparison predicate for the specified types
+/// \param stats - the counters of the sorting
+template<typename T, typename Compare, typename Stats>
+void Sorter::binary_insertion_sort(T *first, T *last, const Compare comp,
+                                   Stats &stats) {
+    for (auto right = first + 1; right <= last; right++) {
+        auto place = std::upper_bound(first, right, *right, comp);
+        if (place == right) continue;
+        T element = std::move(*right);
+        std::move_backward(place, right, right + 1);
+        *place = std::move(element);
+        stats.moved(2 + (right - place));
     }
 }
 
@@ -151,20 +1031,272 @@ T Sorter::select_pivot(T *first, T *last, const Compare comp) {
 /// \param last - reference to the pointer to the last element of the array
 /// \param pivot - unchanged value of pivot for this interval of the array
 /// \param comp - the unchanged comparison predicate for the specified types
+/// \param stats - the counters of the sorting
 /// \return - reference to the pointer to the border element of the array
-template<typename T, typename Compare>
-T *Sorter::partition(T *&first, T *&last, const T pivot, const Compare comp) {
+template<typename T, typename Compare, typename Stats>
+T *Sorter::partition(T *&first, T *&last, const T pivot, const Compare comp,
+                     Stats &&stats) {
     auto left = first, right = last;
     while (true) {
         while (comp(*left, pivot)) left++;
         while (comp(pivot, *right)) right--;
         if (left >= right) return right;
         swap(left, right);
+        stats.moved(3);
         left++;
         right--;
     }
 }
 
+// The function rearranges the elements without conditional jumps
+// (Lomuto scheme): every element is written to the border
+// and the border moves if the element is less than the pivot,
+// so the loop compiles into conditional moves and has no mispredictions.
+// Less than the pivot - [first; border), the pivot - border,
+// not less - (border; last].
+/// \tparam T - type of array elements
+/// \tparam Compare - type of predicat
+/// \param first - pointer to the beginning of the array
+/// \param last - pointer to the last element of the array
+/// \param comp - the unchanged comparison predicate for the specified types
+/// \return - pointer to the pivot after the partition
+template<typename T, typename Compare>
+T *Sorter::branchless_partition(T *first, T *last, const Compare comp) {
+    auto middle = first + (last - first) / 2;
+    auto pivot_place = comp(*first, *last) ?
+            (comp(*first, *middle) ? (comp(*middle, *last) ? middle : last) : first) :
+            (comp(*last, *middle) ? (comp(*middle, *first) ? middle : first) : last);
+    swap(pivot_place, last);
+    const T pivot = *last;
+    auto border = first;
+    for (auto current = first; current < last; current++) {
+        T element = *current;
+        *current = *border;
+        *border = element;
+        border += comp(element, pivot);
+    }
+    swap(border, last);
+    return border;
+}
+
+// The function sorts unsigned integer keys by bytes
+// from the least significant one (LSD radix sort).
+// The counts of all bytes are found in one pass,
+// the bytes equal for all keys are skipped.
+/// \tparam Key - unsigned integer type
+/// \param first - pointer to the beginning of the array
+/// \param last - pointer to an element after the end of the array
+/// \param buffer - pointer to the array of the same length for moving keys
+template<typename Key>
+void Sorter::radix_sort(Key *first, Key *last, Key *buffer) {
+    const auto length = last - first;
+    long counts[sizeof(Key)][256] {};
+    for (auto key = first; key < last; key++)
+        for (unsigned byte = 0; byte < sizeof(Key); byte++)
+            counts[byte][(*key >> (8 * byte)) & 0xFF]++;
+    auto source = first, target = buffer;
+    for (unsigned byte = 0; byte < sizeof(Key); byte++) {
+        auto &count = counts[byte];
+        if (count[(*source >> (8 * byte)) & 0xFF] == length) continue;
+        long offset = 0;
+        for (auto &elem : count) {
+            auto current = elem;
+            elem = offset;
+            offset += current;
+        }
+        for (auto key = source; key < source + length; key++)
+            target[count[(*key >> (8 * byte)) & 0xFF]++] = *key;
+        std::swap(source, target);
+    }
+    if (source != first) std::copy(source, source + length, first);
+}
+
+// The function rearranges the column by the permutation:
+// the element from the row permutation[i] is placed to the row i.
+// Elements are gathered into the buffer by one sequential pass
+// over the destination rows (the next source rows are prefetched)
+// and moved back by the second one,
+// instead of swaps along the cycles of the permutation.
+/// \tparam P - type of the column elements
+/// \param column - pointer to the beginning of the column
+/// \param permutation - the new order of rows
+/// \param buffer - empty buffer with the reserved place for the column
+template<typename P>
+void Sorter::permute(P *column, const std::vector<long> &permutation,
+                     std::vector<P> &buffer) {
+    const auto length = static_cast<long>(permutation.size());
+    for (long i = 0; i < length; i++) {
+#if defined(__GNUC__)
+        if (i + const_sort::prefetch_distance < length)
+            __builtin_prefetch(column + permutation[i + const_sort::prefetch_distance]);
+#endif
+        buffer.push_back(std::move(column[permutation[i]]));
+    }
+    std::move(buffer.begin(), buffer.end(), column);
+}
+
+// The function finds the range of values
+// and checks that it is small enough for counting.
+/// \tparam T - integer type
+/// \param first - pointer to the beginning of the array
+/// \param last - pointer to an element after the end of the array
+/// \param range - found range
+/// \return - the range is small
+template<typename T>
+bool Sorter::find_small_range(T *first, T *last, KeyRange<T> &range) {
+    const auto length = last - first;
+    const auto limit = std::min<std::uint64_t>(2 * length,
+                                               const_sort::counting_max_range);
+    const auto step = std::max<long>(1, length / const_sort::counting_sample_len);
+    range = {*first, *first};
+    for (auto current = first; current < last; current += step) {
+        range.min = std::min(range.min, *current);
+        range.max = std::max(range.max, *current);
+    }
+    if (range_length(range) > limit) return false;
+    for (auto current = first; current < last; current++) {
+        range.min = std::min(range.min, *current);
+        range.max = std::max(range.max, *current);
+    }
+    return range_length(range) <= limit;
+}
+
+// The function counts the values of the range
+// (the whole range of a 64-bit type is saturated to the maximum of uint64_t).
+/// \tparam T - integer type
+/// \param range - the range
+/// \return - number of values in the range
+template<typename T>
+std::uint64_t Sorter::range_length(KeyRange<T> range) {
+    using Unsigned = std::make_unsigned_t<T>;
+    auto distance = static_cast<std::uint64_t>(static_cast<Unsigned>(
+            static_cast<Unsigned>(range.max) - static_cast<Unsigned>(range.min)));
+    return (distance < std::numeric_limits<std::uint64_t>::max()) ?
+           distance + 1 : distance;
+}
+
+// The function counts every value of the range
+// in parts of the array: one part for each thread of the pool
+// if the array is long enough, otherwise one part.
+/// \tparam T - integer type
+/// \param first - pointer to the beginning of the array
+/// \param last - pointer to an element after the end of the array
+/// \param range - all values are in [range.min; range.max]
+/// \return - the histogram of each part
+template<typename T>
+std::vector<std::vector<long>> Sorter::histograms(T *first, T *last,
+                                                  KeyRange<T> range) {
+    using Unsigned = std::make_unsigned_t<T>;
+    const auto length = last - first;
+    const auto buckets = range_length(range);
+    const long parts = (length >= const_sort::counting_parallel_len) ?
+            ThreadPool::shared().size() : 1;
+    std::vector<std::vector<long>> result(parts, std::vector<long>(buckets));
+    auto count = [=, &result](long part) {
+        auto &histogram = result[part];
+        for (auto current = first + length * part / parts;
+             current < first + length * (part + 1) / parts; current++) {
+            if ((*current < range.min) || (range.max < *current))
+                throw std::invalid_argument(ILLEGAL_ARG_RANGE_EXC_MESSAGE);
+            histogram[static_cast<Unsigned>(static_cast<Unsigned>(*current) -
+                                            static_cast<Unsigned>(range.min))]++;
+        }
+    };
+    if (parts == 1) count(0);
+    else {
+        ThreadPool::TaskGroup group;
+        for (long part = 0; part < parts; part++)
+            ThreadPool::shared().submit(group, [=]() {count(part);});
+        group.wait();
+    }
+    return result;
+}
+
+// The function sorts integers by counting:
+// writes each value of the range as many times as it was counted.
+/// \tparam T - integer type
+/// \param first - pointer to the beginning of the array
+/// \param last - pointer to an element after the end of the array
+/// \param range - all values are in [range.min; range.max]
+template<typename T>
+void Sorter::counting_sort(T *first, T *last, KeyRange<T> range) {
+    using Unsigned = std::make_unsigned_t<T>;
+    auto parts = histograms(first, last, range);
+    auto &histogram = parts[0];
+    for (std::size_t part = 1; part < parts.size(); part++)
+        for (std::size_t bucket = 0; bucket < histogram.size(); bucket++)
+            histogram[bucket] += parts[part][bucket];
+    auto current = first;
+    for (std::size_t bucket = 0; bucket < histogram.size(); bucket++)
+        current = std::fill_n(current, histogram[bucket], static_cast<T>(
+                static_cast<Unsigned>(static_cast<Unsigned>(range.min) + bucket)));
+}
+
+// The function sorts integer keys stably by counting:
+// every part of the array gets its own place for each key
+// after the same keys of the previous parts,
+// and the parts move their keys and values to the buffers
+// (in parallel if there are several parts).
+/// \tparam K - integer type of keys
+/// \tparam V - type of values
+/// \param first - pointer to the beginning of the keys
+/// \param last - pointer to an element after the end of the keys
+/// \param values - pointer to the beginning of the values
+/// \param range - all keys are in [range.min; range.max]
+template<typename K, typename V>
+void Sorter::counting_sort_by_key(K *first, K *last, V *values,
+                                  KeyRange<K> range) {
+    using Unsigned = std::make_unsigned_t<K>;
+    const auto length = last - first;
+    auto offsets = histograms(first, last, range);
+    const auto parts = static_cast<long>(offsets.size());
+    long offset = 0;
+    for (std::size_t bucket = 0; bucket < offsets[0].size(); bucket++)
+        for (auto &histogram : offsets) {
+            auto count = histogram[bucket];
+            histogram[bucket] = offset;
+            offset += count;
+        }
+    std::vector<K> keys_buffer(length);
+    std::vector<V> values_buffer;
+    values_buffer.reserve(length);
+    for (long i = 0; i < length; i++) values_buffer.push_back(std::move(values[i]));
+    auto scatter = [=, &offsets, &keys_buffer, &values_buffer](long part) {
+        auto &offset = offsets[part];
+        for (auto i = length * part / parts; i < length * (part + 1) / parts; i++) {
+            auto place = offset[static_cast<Unsigned>(
+                    static_cast<Unsigned>(first[i]) -
+                    static_cast<Unsigned>(range.min))]++;
+            keys_buffer[place] = first[i];
+            values[place] = std::move(values_buffer[i]);
+        }
+    };
+    if (parts == 1) scatter(0);
+    else {
+        ThreadPool::TaskGroup group;
+        for (long part = 0; part < parts; part++)
+            ThreadPool::shared().submit(group, [=]() {scatter(part);});
+        group.wait();
+    }
+    std::copy(keys_buffer.begin(), keys_buffer.end(), first);
+}
+
+// The function adds counting of the calls to the predicate
+// (the predicate is not changed without counters).
+/// \tparam Compare - type of predicat
+/// \tparam Stats - SortStats or NoSortStats
+/// \param comp - the comparison predicate
+/// \param stats - the counters of the sorting
+/// \return - the predicate with counting
+template<typename Compare, typename Stats>
+auto Sorter::counting(Compare comp, Stats &stats) {
+    if constexpr (std::is_same_v<Stats, NoSortStats>) return comp;
+    else return [comp, &stats](const auto &a, const auto &b) {
+        stats.compared();
+        return comp(a, b);
+    };
+}
+
 // The function swaps the values of two variables stored at these addresses.
 /// \tparam T - type of elements
 /// \param first - pointer to the first element
@@ -0,0 +1,63 @@
+/**
+ * Pool of threads performing the tasks of the parallel sorting.
+ */
+
+#ifndef QUICKSORT_THREAD_POOL_HPP
+#define QUICKSORT_THREAD_POOL_HPP
+
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <vector>
+
+// Fixed set of threads taking the tasks from the common queue.
+// The tasks are submitted with a group, and the group waits
+// for its own tasks only, so several sortings can share one pool.
+// A task can submit new tasks of its group.
+// Example:
+//      ThreadPool::TaskGroup group;
+//      for (int i = 0; i < 4; ++i)
+//          ThreadPool::shared().submit(group, [i]() {std::cout << i;});
+//      group.wait();
+class ThreadPool final {
+public:
+    // Counter of the unfinished tasks submitted together.
+    class TaskGroup {
+        std::mutex mutex;
+        std::condition_variable finished;
+        int pending = 0;
+        std::exception_ptr error;
+        friend class ThreadPool;
+    public:
+        void wait();
+    };
+
+private:
+    struct Task {
+        TaskGroup *group;
+        std::function<void()> function;
+    };
+    std::vector<std::thread> threads;
+    std::queue<Task> tasks;
+    std::mutex mutex;
+    std::condition_variable available;
+    bool stopped;
+
+public:
+    explicit ThreadPool(unsigned thread_count = std::thread::hardware_concurrency());
+    ThreadPool(const ThreadPool &) = delete;
+    ThreadPool &operator =(const ThreadPool &) = delete;
+    ~ThreadPool();
+
+    unsigned size() const {return static_cast<unsigned>(threads.size());}
+    void submit(TaskGroup &, std::function<void()>);
+
+    static ThreadPool &shared();
+private:
+    void work();
+};
+
+#endif //QUICKSORT_THREAD_POOL_HPP
@@ -6,6 +6,10 @@
 #ifndef QUICKSORT_TIME_METER_HPP
 #define QUICKSORT_TIME_METER_HPP
 
+#include <functional>
+#include <random>
+#include <vector>
+
 #include "constants.hpp"
 #include "sorter.hpp"
 
@@ -13,8 +17,30 @@
 #define EXPERIMENT_COUNT_LOW_LIMIT_MESSAGE "Not enough experiments\n"
 #define UNEXPECTED_EXP_MES "Unexpected error in experiment "
 
+// Robust statistics of the repeated measurements (in seconds).
+struct MeasureStats {
+    double median = 0;
+    // median absolute deviation from the median
+    double mad = 0;
+    // confidence interval of the median (95%) by order statistics
+    double confidence_low = 0;
+    double confidence_high = 0;
+    int repetitions = 0;
+    // the frequency of the processor changed during the measurement
+    bool frequency_changed = false;
+    // the deviation is too large in comparison with the median
+    bool noisy = false;
+
+    bool is_disturbed() const {return frequency_changed || noisy;}
+};
+
 // Performs experiments on selecting the length of the interval
 // in which the insertion sort takes place for the class Sorter.
+// Every time is measured experiment_count times after warmup_count
+// unmeasured runs, the arrays are generated from the explicit seed
+// (two runs with the same seed measure the same data),
+// the thread is pinned to one processor during the measurement,
+// and the medians are compared instead of the sums.
 // Example:
 //      int experiment_count = 10;
 //      TimeMeter time_meter(experiment_count);
@@ -22,14 +48,28 @@
 //      Sorter sorter(optimal_length);
 class TimeMeter {
     int experiment_count;
+    unsigned seed;
+    int warmup_count;
+    // processor for pinning, -1 - without pinning
+    int cpu;
+    std::mt19937 generator;
 public:
-    explicit TimeMeter(int experiment_count = 3)
-    :experiment_count(experiment_count) {}
+    explicit TimeMeter(int experiment_count =
+            const_time_meter::experiment_count_default,
+                       unsigned seed = const_time_meter::seed_default,
+                       int warmup_count = const_time_meter::warmup_count_default,
+                       int cpu = const_time_meter::cpu_default);
 
     int experiment_with_array_count();
-    void print_first_comparings(int) const;
+    void print_first_comparings(int);
+
+    MeasureStats measure(const std::function<void()> &,
+                         const std::function<void()> &);
+    static MeasureStats statistics(std::vector<double>);
 private:
-    bool is_for_insertion_sort(int) const;
+    bool is_for_insertion_sort(int);
+    void compare_sortings(int, MeasureStats &, MeasureStats &);
+    void fill(std::vector<int> &);
 };
 
 
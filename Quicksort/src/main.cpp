@@ -1,14 +1,52 @@
 /**
  * Use the command line to pass the string "LESS" or "GREATER",
  * followed by an array separated by spaces.
+ * Or pass the string "LINES", the delimiter and the number of the key field
+ * (as sort -t, -k3,3: only this field is compared, the lines with equal
+ * fields are ordered by the whole lines), followed by the path
+ * to the text file, to print the lines of the file sorted by this field:
+ *      Quicksort LINES -t, -k3 data.csv
+ *      Quicksort LINES -t , -k 3 data.csv
 **/
 
+#include <climits>
+#include <cstdlib>
 #include <cstring>
+#include <iostream>
 #include <memory>
+#include <string>
+
+#include <unistd.h>
 
 #include <sorter/sorter.hpp>
+#include "sorter/line_sorter.hpp"
 #include "sorter/time_meter.hpp"
 
+namespace {
+    // The function returns the value of the option given as -tX or -t X
+    // and moves the index to the next argument in the second case.
+    /// \param argc - number of arguments
+    /// \param argv - arguments
+    /// \param i - index of the option, the index of its value after the call
+    /// \return - the value of the option, nullptr if it is missing
+    const char *option_value(int argc, char **argv, int &i) {
+        if (argv[i][2] != '\0') return argv[i] + 2;
+        return (++i < argc) ? argv[i] : nullptr;
+    }
+
+    // The function parses the number of the field.
+    /// \param value - the value of the option
+    /// \return - the number of the field, 0 if it is not a positive number
+    int field_number(const char *value) {
+        char *end = nullptr;
+        auto number = std::strtol(value, &end, 10);
+        if ((end == value) || (*end != '\0') || (number < 1) ||
+            (number > INT_MAX))
+            return 0;
+        return static_cast<int>(number);
+    }
+}
+
 int main(int argc, char **argv) {
     //TimeMeter time_meter(100000);
     //std::cout << time_meter.experiment_with_array_count() <<std::endl;
@@ -28,6 +66,42 @@ int main(int argc, char **argv) {
     //Size: 14 Time of quicksort: 0.0389185 Time of insertion sort: 0.0387897
     //Size: 15 Time of quicksort: 0.0393646 Time of insertion sort: 0.0425735
     //14 - SIZE FOR INSERTION SORT
+    if ((argc > 1) && (strcmp("LINES", argv[1]) == 0)) {
+        auto delimiter = '\t';
+        auto field = 1;
+        std::string path;
+        try {
+            for (auto i = 2; i < argc; i++) {
+                if (strncmp("-t", argv[i], 2) == 0) {
+                    auto value = option_value(argc, argv, i);
+                    if ((value == nullptr) || (strlen(value) != 1)) {
+                        std::cerr << LINES_USAGE_MESSAGE << std::endl;
+                        return 1;
+                    }
+                    delimiter = value[0];
+                }
+                else if (strncmp("-k", argv[i], 2) == 0) {
+                    auto value = option_value(argc, argv, i);
+                    field = (value == nullptr) ? 0 : field_number(value);
+                    if (field == 0) {
+                        std::cerr << LINES_USAGE_MESSAGE << std::endl;
+                        return 1;
+                    }
+                }
+                else path = argv[i];
+            }
+            if (path.empty()) {
+                std::cerr << LINES_USAGE_MESSAGE << std::endl;
+                return 1;
+            }
+            LineSorter(delimiter, field).sort_file(path, STDOUT_FILENO);
+        }
+        catch (const std::exception &error) {
+            std::cerr << error.what() << std::endl;
+            return 1;
+        }
+        return 0;
+    }
     auto first_argc_index = ((argc > 1) &&
             ((strcmp("LESS", argv[1]) == 0) ||
             (strcmp("GREATER", argv[1]) == 0))) ? 2 : 1;
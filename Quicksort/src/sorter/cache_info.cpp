@@ -0,0 +1,50 @@
+/**
+ * Sizes of the processor caches are read from
+ * /sys/devices/system/cpu/cpu0/cache/index<N>/{level,type,size}.
+ */
+
+#include <fstream>
+#include <string>
+
+#include "sorter/cache_info.hpp"
+#include "constants.hpp"
+
+// The function reads the size of the data cache of the level.
+/// \param level - level of the cache (1, 2, 3)
+/// \return - size in bytes or 0 if it is unknown
+std::size_t cache_size(int level) {
+    const std::string directory = "/sys/devices/system/cpu/cpu0/cache/index";
+    for (auto index = 0; ; index++) {
+        std::ifstream level_file(directory + std::to_string(index) + "/level");
+        if (!level_file) return 0;
+        int current_level = 0;
+        level_file >> current_level;
+        if (current_level != level) continue;
+
+        std::ifstream type_file(directory + std::to_string(index) + "/type");
+        std::string type;
+        type_file >> type;
+        if (type == "Instruction") continue;
+
+        std::ifstream size_file(directory + std::to_string(index) + "/size");
+        std::size_t size = 0;
+        std::string unit;
+        if (!(size_file >> size)) return 0;
+        size_file >> unit;
+        if (unit == "K") size <<= 10;
+        else if (unit == "M") size <<= 20;
+        else if (unit == "G") size <<= 30;
+        return size;
+    }
+}
+
+// The function gives the size of the block for sorting in the cache
+// remembered after the first reading of the size of L2.
+/// \return - size in bytes
+std::size_t cache_block_size() {
+    static const std::size_t block_size = [] {
+        auto l2_size = cache_size(2);
+        return (l2_size == 0 ? const_sort::l2_size_default : l2_size) / 2;
+    }();
+    return block_size;
+}
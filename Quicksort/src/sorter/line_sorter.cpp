@@ -0,0 +1,157 @@
+/**
+ * Sorting the lines of a text file by a delimited field.
+ */
+
+#include <algorithm>
+#include <climits>
+#include <stdexcept>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+#include "sorter/line_sorter.hpp"
+
+namespace {
+    // Mapping of the whole file for reading,
+    // unmapped and closed in the destructor.
+    class MappedFile {
+        int descriptor;
+        void *data;
+        std::size_t size;
+    public:
+        explicit MappedFile(const std::string &path)
+        : descriptor(-1), data(MAP_FAILED), size(0) {
+            descriptor = open(path.c_str(), O_RDONLY);
+            if (descriptor < 0)
+                throw std::runtime_error(FILE_OPEN_EXC_MESSAGE + path);
+            struct stat status {};
+            if (fstat(descriptor, &status) != 0) {
+                close(descriptor);
+                throw std::runtime_error(FILE_OPEN_EXC_MESSAGE + path);
+            }
+            size = static_cast<std::size_t>(status.st_size);
+            if (size == 0) return;
+            data = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, descriptor, 0);
+            if (data == MAP_FAILED) {
+                close(descriptor);
+                throw std::runtime_error(FILE_MAP_EXC_MESSAGE + path);
+            }
+            // the lines are scanned once and then compared in random order
+            madvise(data, size, MADV_WILLNEED);
+        }
+        MappedFile(const MappedFile &) = delete;
+        MappedFile &operator =(const MappedFile &) = delete;
+        ~MappedFile() {
+            if (data != MAP_FAILED) munmap(data, size);
+            close(descriptor);
+        }
+
+        std::string_view text() const {
+            if (data == MAP_FAILED) return {};
+            return {static_cast<const char *>(data), size};
+        }
+    };
+
+    // Comparison of the lines by the cached prefixes,
+    // by the whole keys if the prefixes are equal
+    // and by the whole lines if the keys are equal (as sort without -s),
+    // so the order does not depend on the unstable sorting.
+    bool isLessLine(const LineSorter::Line &a, const LineSorter::Line &b) {
+        if (a.prefix != b.prefix) return a.prefix < b.prefix;
+        if (a.key != b.key) return a.key < b.key;
+        return a.text < b.text;
+    }
+}
+
+// The constructor sets the delimiter and the number of the key field.
+/// \param delimiter - separator of the fields
+/// \param field - number of the key field from 1
+LineSorter::LineSorter(char delimiter, int field)
+: delimiter(delimiter), field(field) {
+    if (field < 1) throw std::invalid_argument(ILLEGAL_ARG_FIELD_EXC_MESSAGE);
+}
+
+// The function splits the text into lines and sorts them by the key.
+// The lines refer to the text, the last line may be without '\n'.
+/// \param text - the text
+/// \return - descriptors of the lines in sorted order
+std::vector<LineSorter::Line> LineSorter::sort_lines(std::string_view text) {
+    std::vector<Line> lines;
+    lines.reserve(std::count(text.begin(), text.end(), '\n') + 1);
+    while (!text.empty()) {
+        auto end = text.find('\n');
+        auto length = (end == std::string_view::npos) ? text.size() : end + 1;
+        lines.push_back(describe(text.substr(0, length)));
+        text.remove_prefix(length);
+    }
+    sorter.sort(lines.data(), lines.data() + lines.size(), isLessLine);
+    return lines;
+}
+
+// The function maps the file, sorts its lines and writes them.
+/// \param path - path to the file
+/// \param output - descriptor of the output file
+void LineSorter::sort_file(const std::string &path, int output) {
+    MappedFile file(path);
+    write_lines(sort_lines(file.text()), output);
+}
+
+// The function finds the key field of the line and caches its prefix.
+/// \param text - the line with '\n' at the end (if it is present)
+/// \return - descriptor of the line
+LineSorter::Line LineSorter::describe(std::string_view text) const {
+    auto content = text;
+    if (!content.empty() && (content.back() == '\n')) content.remove_suffix(1);
+    std::string_view key;
+    std::size_t begin = 0;
+    for (auto number = 1; number < field; number++) {
+        begin = content.find(delimiter, begin);
+        if (begin == std::string_view::npos) break;
+        begin++;
+    }
+    if (begin != std::string_view::npos) {
+        auto end = content.find(delimiter, begin);
+        key = content.substr(begin, (end == std::string_view::npos) ?
+                                    std::string_view::npos : end - begin);
+    }
+    std::uint64_t prefix = 0;
+    for (std::size_t i = 0; i < sizeof(prefix); i++)
+        prefix = (prefix << 8) |
+                 ((i < key.size()) ? static_cast<unsigned char>(key[i]) : 0);
+    return {text, key, prefix};
+}
+
+// The function writes the lines in the given order by writev
+// (every line ends with '\n').
+/// \param lines - descriptors of the lines
+/// \param output - descriptor of the output file
+void LineSorter::write_lines(const std::vector<Line> &lines, int output) {
+    static char new_line[] = "\n";
+    std::vector<iovec> parts;
+    auto flush = [&parts, output]() {
+        auto part = parts.data(), end = parts.data() + parts.size();
+        while (part < end) {
+            auto count = std::min<long>(end - part, IOV_MAX);
+            auto written = writev(output, part, static_cast<int>(count));
+            if (written < 0) throw std::runtime_error(FILE_WRITE_EXC_MESSAGE);
+            while ((part < end) && (static_cast<std::size_t>(written) >= part->iov_len)) {
+                written -= static_cast<ssize_t>(part->iov_len);
+                part++;
+            }
+            if ((part < end) && (written > 0)) {
+                part->iov_base = static_cast<char *>(part->iov_base) + written;
+                part->iov_len -= written;
+            }
+        }
+        parts.clear();
+    };
+    for (const auto &line : lines) {
+        parts.push_back({const_cast<char *>(line.text.data()), line.text.size()});
+        if (line.text.back() != '\n') parts.push_back({new_line, 1});
+        if (parts.size() >= const_sort::write_batch_len) flush();
+    }
+    flush();
+}
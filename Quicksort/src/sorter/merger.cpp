@@ -0,0 +1,15 @@
+/**
+ * The implementation of template functions is located in the header file
+ * include/sorter/merger.hpp.
+ *
+ * Public methods of class Merger:
+ * merge(pointer_to_the_first_sorted_input,
+ *      pointer_to_an_input_after_the_last_one,
+ *      pointer_to_the_beginning_of_the_output_array,
+ *      the_comparison_predicate_for_the_specified_types)
+ * split(pointer_to_the_first_sorted_input,
+ *      pointer_to_an_input_after_the_last_one,
+ *      position_in_the_merged_output,
+ *      array_for_the_number_of_elements_of_each_input,
+ *      the_comparison_predicate_for_the_specified_types)
+ */
@@ -0,0 +1,267 @@
+/**
+ * Sorting an template array in shared memory by several processes.
+ * The implementation of template functions is located in the header file
+ * include/sorter/process_sorter.hpp.
+ */
+
+#include <cerrno>
+#include <cstdint>
+#include <cstdio>
+#include <exception>
+#include <fstream>
+#include <new>
+#include <utility>
+
+#include <fcntl.h>
+#include <sched.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include "sorter/process_sorter.hpp"
+
+/*
+ * Methods of SharedSegment
+ */
+
+// The constructor creates the segment with the name and maps it.
+/// \param segment_name - name of the segment ("/name")
+/// \param size - size of the segment in bytes
+SharedSegment::SharedSegment(std::string segment_name, std::size_t size)
+: name(std::move(segment_name)), data(MAP_FAILED), length(size), owner(true) {
+    auto descriptor = shm_open(name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0600);
+    if (descriptor < 0) throw std::runtime_error(SHARED_MEMORY_EXC_MESSAGE + name);
+    if (ftruncate(descriptor, static_cast<off_t>(length)) != 0) {
+        close(descriptor);
+        shm_unlink(name.c_str());
+        throw std::runtime_error(SHARED_MEMORY_EXC_MESSAGE + name);
+    }
+    map(descriptor);
+}
+
+// The constructor maps the existing segment with the name.
+/// \param segment_name - name of the segment ("/name")
+SharedSegment::SharedSegment(std::string segment_name)
+: name(std::move(segment_name)), data(MAP_FAILED), length(0), owner(false) {
+    auto descriptor = shm_open(name.c_str(), O_RDWR, 0600);
+    if (descriptor < 0) throw std::runtime_error(SHARED_MEMORY_EXC_MESSAGE + name);
+    struct stat status {};
+    if (fstat(descriptor, &status) != 0) {
+        close(descriptor);
+        throw std::runtime_error(SHARED_MEMORY_EXC_MESSAGE + name);
+    }
+    length = static_cast<std::size_t>(status.st_size);
+    map(descriptor);
+}
+
+// The destructor unmaps the segment, the creator removes its name.
+SharedSegment::~SharedSegment() {
+    if (data != MAP_FAILED) munmap(data, length);
+    if (owner) shm_unlink(name.c_str());
+}
+
+// The function maps the opened segment and closes its descriptor.
+/// \param descriptor - descriptor of the segment
+void SharedSegment::map(int descriptor) {
+    if (length > 0)
+        data = mmap(nullptr, length, PROT_READ | PROT_WRITE, MAP_SHARED,
+                    descriptor, 0);
+    close(descriptor);
+    if ((length > 0) && (data == MAP_FAILED)) {
+        if (owner) shm_unlink(name.c_str());
+        throw std::runtime_error(SHARED_MEMORY_EXC_MESSAGE + name);
+    }
+}
+
+/*
+ * Methods of ProcessSorter
+ */
+
+// The constructor sets the number of processes.
+/// \param process_init_count - number of processes including the current one,
+/// 0 - number of online processors
+/// \param sorter - the sorting of short intervals
+ProcessSorter::ProcessSorter(int process_init_count, Sorter sorter)
+: process_count(process_init_count), sorter(sorter) {
+    if (process_count <= 0)
+        process_count = static_cast<int>(sysconf(_SC_NPROCESSORS_ONLN));
+    if (process_count <= 0) process_count = 1;
+}
+
+// The function places the queue with the whole array in shared memory,
+// forks the helpers and sorts the intervals from the queue
+// in all processes until every interval is sorted.
+/// \param length - length of the array
+/// \param sort_interval - the sorting of one interval of the array
+void ProcessSorter::run(long length, const IntervalSorting &sort_interval) {
+    // the capacity is a hint for balanced partitions (about two intervals
+    // per process_len elements), the shorter part which does not fit
+    // into the full queue is sorted by the process which has partitioned
+    long capacity = 1;
+    while (capacity < 2 * (length / const_sort::process_len) + 2) capacity *= 2;
+    auto memory_size = IntervalQueue::memory_size(capacity);
+    auto memory = mmap(nullptr, memory_size, PROT_READ | PROT_WRITE,
+                       MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+    if (memory == MAP_FAILED) throw std::runtime_error(PROCESS_EXC_MESSAGE);
+    auto &queue = *new(memory) IntervalQueue(capacity);
+    queue.push({0, length});
+
+    std::vector<pid_t> helpers;
+    for (auto i = 1; i < process_count; i++) {
+        auto helper = fork();
+        if (helper < 0) break;
+        if (helper == 0) {
+            auto status = 0;
+            try {
+                work(queue, sort_interval, nullptr);
+            }
+            catch (...) {
+                queue.fail();
+                status = 1;
+            }
+            _exit(status);
+        }
+        helpers.push_back(helper);
+    }
+
+    std::exception_ptr error;
+    try {
+        work(queue, sort_interval, &helpers);
+    }
+    catch (...) {
+        queue.fail();
+        error = std::current_exception();
+    }
+    for (auto helper : helpers) {
+        auto status = 0;
+        while ((waitpid(helper, &status, 0) < 0) && (errno == EINTR));
+        if (!WIFEXITED(status) || (WEXITSTATUS(status) != 0)) queue.fail();
+    }
+    auto failed = queue.isFailed();
+    queue.~IntervalQueue();
+    munmap(memory, memory_size);
+    if (error) std::rethrow_exception(error);
+    if (failed) throw std::runtime_error(PROCESS_EXC_MESSAGE);
+}
+
+// The function sorts the intervals from the queue until all of them
+// are sorted or one of the processes fails.
+// The current process also checks that the helpers have not terminated.
+/// \param queue - the queue of intervals
+/// \param sort_interval - the sorting of one interval of the array
+/// \param helpers - process IDs of the helpers, nullptr - in the helper
+void ProcessSorter::work(IntervalQueue &queue, const IntervalSorting &sort_interval,
+                         std::vector<pid_t> *helpers) {
+    Interval interval {};
+    while (!queue.isDone() && !queue.isFailed()) {
+        if (queue.pop(interval)) {
+            sort_interval(interval, queue);
+            queue.finish();
+            continue;
+        }
+        if (helpers != nullptr)
+            for (auto helper = helpers->begin(); helper < helpers->end(); ) {
+                auto status = 0;
+                if (waitpid(*helper, &status, WNOHANG) == *helper) {
+                    if (!WIFEXITED(status) || (WEXITSTATUS(status) != 0))
+                        queue.fail();
+                    helper = helpers->erase(helper);
+                }
+                else helper++;
+            }
+        sched_yield();
+    }
+}
+
+// The function checks that the memory of the array is shared
+// (the whole range is covered by MAP_SHARED mappings of /proc/self/maps).
+/// \param first - pointer to the beginning of the array
+/// \param last - pointer to an element after the end of the array
+/// \return - the array is in the shared memory
+bool ProcessSorter::isShared(const void *first, const void *last) {
+    std::ifstream maps("/proc/self/maps");
+    auto position = reinterpret_cast<std::uintptr_t>(first);
+    auto end = reinterpret_cast<std::uintptr_t>(last);
+    std::string line;
+    while (std::getline(maps, line)) {
+        unsigned long start = 0, stop = 0;
+        char permissions[5] {};
+        if (std::sscanf(line.c_str(), "%lx-%lx %4s", &start, &stop, permissions) != 3)
+            return false;
+        if (stop <= position) continue;
+        if ((start > position) || (permissions[3] != 's')) return false;
+        position = stop;
+        if (position >= end) return true;
+    }
+    return false;
+}
+
+/*
+ * Methods of IntervalQueue
+ */
+
+// The constructor places the free cells after the queue.
+/// \param capacity - number of cells (a power of two)
+ProcessSorter::IntervalQueue::IntervalQueue(long capacity)
+: cells(reinterpret_cast<Cell *>(this + 1)), mask(capacity - 1),
+tail(0), head(0), unfinished(0), failed(false) {
+    for (long i = 0; i < capacity; i++) {
+        new(cells + i) Cell();
+        cells[i].sequence.store(i, std::memory_order_relaxed);
+    }
+}
+
+// The function finds the size of the memory for the queue with its cells.
+/// \param capacity - number of cells
+/// \return - size in bytes
+std::size_t ProcessSorter::IntervalQueue::memory_size(long capacity) {
+    return sizeof(IntervalQueue) + capacity * sizeof(Cell);
+}
+
+// The function adds the unfinished interval to the queue:
+// takes the free cell at the tail and marks it as filled.
+/// \param interval - the interval
+/// \return - the interval is added (true) or the queue is full (false)
+bool ProcessSorter::IntervalQueue::push(Interval interval) {
+    unfinished.fetch_add(1, std::memory_order_acq_rel);
+    auto position = tail.load(std::memory_order_relaxed);
+    while (true) {
+        auto &cell = cells[position & mask];
+        auto difference = cell.sequence.load(std::memory_order_acquire) - position;
+        if (difference == 0) {
+            if (tail.compare_exchange_weak(position, position + 1,
+                                           std::memory_order_relaxed)) {
+                cell.interval = interval;
+                cell.sequence.store(position + 1, std::memory_order_release);
+                return true;
+            }
+        }
+        else if (difference < 0) {
+            finish();
+            return false;
+        }
+        else position = tail.load(std::memory_order_relaxed);
+    }
+}
+
+// The function takes the filled cell at the head and marks it as free.
+/// \param interval - the taken interval
+/// \return - the interval is taken (true) or the queue is empty (false)
+bool ProcessSorter::IntervalQueue::pop(Interval &interval) {
+    auto position = head.load(std::memory_order_relaxed);
+    while (true) {
+        auto &cell = cells[position & mask];
+        auto difference = cell.sequence.load(std::memory_order_acquire) - (position + 1);
+        if (difference == 0) {
+            if (head.compare_exchange_weak(position, position + 1,
+                                           std::memory_order_relaxed)) {
+                interval = cell.interval;
+                cell.sequence.store(position + mask + 1, std::memory_order_release);
+                return true;
+            }
+        }
+        else if (difference < 0) return false;
+        else position = head.load(std::memory_order_relaxed);
+    }
+}
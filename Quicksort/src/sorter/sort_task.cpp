@@ -0,0 +1,63 @@
+/**
+ * Sorting running in the background thread
+ * with cancellation and progress reporting.
+ */
+
+#include <exception>
+
+#include "constants.hpp"
+#include "sorter/sort_task.hpp"
+
+// The constructor submits the sorting to the pool of the background sortings.
+/// \param job - the sorting
+/// \param total - number of elements of the array
+/// \param token - external token for cancellation of the sorting
+SortTask::SortTask(Job job, long total, std::stop_token token)
+: state(std::make_shared<State>()), total(total) {
+    auto promise = std::make_shared<std::promise<bool>>();
+    result = promise->get_future();
+    if (token.stop_possible())
+        external_stop = std::make_unique<std::stop_callback<std::function<void()>>>(
+                token, std::function<void()>([state = state]() {
+                    state->source.request_stop();
+                }));
+    executor().submit(state->group, [job = std::move(job), state = state, promise]() {
+        try {
+            promise->set_value(job(state->source.get_token(), state->finished));
+        }
+        catch (...) {
+            promise->set_exception(std::current_exception());
+        }
+    });
+}
+
+// The destructor cancels the unfinished sorting and waits for its end.
+SortTask::~SortTask() {
+    if (!state) return;
+    cancel();
+    state->group.wait();
+}
+
+// The function returns the pool of the background sortings.
+ThreadPool &SortTask::executor() {
+    static ThreadPool pool(const_sort::async_thread_count);
+    return pool;
+}
+
+// Returns the fraction of elements in the finished intervals.
+/// \return - progress from 0 to 1
+double SortTask::progress() const {
+    if (total <= 0) return 1;
+    return static_cast<double>(state->finished.load()) / total;
+}
+
+// Requests the cancellation of the sorting.
+void SortTask::cancel() {state->source.request_stop();}
+
+// Waits for the end of the sorting.
+/// \return - the array is sorted (true) or the sorting was cancelled (false)
+bool SortTask::get() {
+    auto sorted = result.get();
+    state->group.wait();
+    return sorted;
+}
@@ -0,0 +1,11 @@
+/**
+ * The implementation of template functions is located in the header file
+ * include/sorter/sorted_buffer.hpp.
+ *
+ * Public methods of class SortedBuffer:
+ * insert(value)
+ * flush() - sorts the appended values
+ * sorted() - returns pointers to all values merged into one sorted array
+ * iterator() - returns the iterator reading the values in sorted order
+ * size(), runCount(), clear()
+ */
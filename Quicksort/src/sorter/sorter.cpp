@@ -7,6 +7,37 @@
  *      pointer_to_an_element_after_the_end_of_the_array,
  *      the_comparison_predicate_for_the_specified_types/
  *      LESS(type)_identifier/GREATER(type)_identifier)
+ * sort<SortStats>(the_same_arguments) - returns the counters of the work
+ * sort_total_order(pointer_to_the_beginning_of_the_float_array,
+ *      pointer_to_an_element_after_the_end_of_the_array,
+ *      place_NaNs_at_the_end)
+ * sort_columns(pointer_to_the_beginning_of_the_keys,
+ *      pointer_to_an_element_after_the_end_of_the_keys,
+ *      the_comparison_predicate_for_keys,
+ *      pointers_to_the_beginnings_of_the_payload_columns...)
+ * sort_cache_tiled(pointer_to_the_beginning_of_the_array,
+ *      pointer_to_an_element_after_the_end_of_the_array,
+ *      the_comparison_predicate_for_the_specified_types[,
+ *      number_of_elements_in_a_block])
+ * sort_small_range(pointer_to_the_beginning_of_the_integer_array,
+ *      pointer_to_an_element_after_the_end_of_the_array[,
+ *      KeyRange{min, max}])
+ * sort_small_range_by_key(pointer_to_the_beginning_of_the_integer_keys,
+ *      pointer_to_an_element_after_the_end_of_the_keys,
+ *      pointer_to_the_beginning_of_the_values[, KeyRange{min, max}])
+ * sort_unique(pointer_to_the_beginning_of_the_array,
+ *      pointer_to_an_element_after_the_end_of_the_array,
+ *      the_comparison_predicate_for_the_specified_types) - returns new end
+ * sort_reduce_by_key(pointer_to_the_beginning_of_the_keys,
+ *      pointer_to_an_element_after_the_end_of_the_keys,
+ *      pointer_to_the_beginning_of_the_values,
+ *      the_comparison_predicate_for_keys,
+ *      the_function_combining_two_values) - returns new end of the keys
+ * set_comparator_cost(ComparatorCost::cheap/ComparatorCost::expensive)
+ *      - replaces the insertion length given to the constructor
+ * calibrate<optional_clock>(pointer_to_the_beginning_of_the_sample_array,
+ *      pointer_to_an_element_after_the_end_of_the_array,
+ *      the_comparison_predicate_for_the_specified_types)
  * print(pointer_to_the_beginning_of_the_array,
  *      pointer_to_an_element_after_the_end_of_the_array)
  */
\ No newline at end of file
@@ -0,0 +1,84 @@
+/**
+ * Pool of threads performing the tasks of the parallel sorting.
+ */
+
+#include "sorter/thread_pool.hpp"
+
+// The constructor starts the threads of the pool.
+/// \param thread_count - number of threads, at least one thread is started
+ThreadPool::ThreadPool(unsigned thread_count)
+: stopped(false) {
+    if (thread_count == 0) thread_count = 1;
+    for (unsigned i = 0; i < thread_count; i++)
+        threads.emplace_back([this]() {work();});
+}
+
+// The destructor finishes the queued tasks and joins the threads.
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopped = true;
+    }
+    available.notify_all();
+    for (auto &thread : threads) thread.join();
+}
+
+// The function adds the task to the queue.
+/// \param group - group which waits for the task
+/// \param function - the task
+void ThreadPool::submit(TaskGroup &group, std::function<void()> function) {
+    {
+        std::lock_guard<std::mutex> lock(group.mutex);
+        group.pending++;
+    }
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        tasks.push({&group, std::move(function)});
+    }
+    available.notify_one();
+}
+
+// The function returns the pool common for all sortings
+// with a thread for each hardware thread.
+ThreadPool &ThreadPool::shared() {
+    static ThreadPool pool;
+    return pool;
+}
+
+// The loop of the thread: takes the tasks until the pool is stopped
+// and the queue is empty.
+// The first exception of the group's tasks is kept in the group.
+void ThreadPool::work() {
+    while (true) {
+        Task task;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            available.wait(lock, [this]() {return stopped || !tasks.empty();});
+            if (tasks.empty()) return;
+            task = std::move(tasks.front());
+            tasks.pop();
+        }
+        std::exception_ptr error;
+        try {
+            task.function();
+        }
+        catch (...) {
+            error = std::current_exception();
+        }
+        std::lock_guard<std::mutex> lock(task.group->mutex);
+        if (error && !task.group->error) task.group->error = error;
+        if (--task.group->pending == 0) task.group->finished.notify_all();
+    }
+}
+
+// The function waits until all tasks of the group are finished
+// and rethrows the first exception of them.
+void ThreadPool::TaskGroup::wait() {
+    std::unique_lock<std::mutex> lock(mutex);
+    finished.wait(lock, [this]() {return pending == 0;});
+    if (error) {
+        auto result = error;
+        error = nullptr;
+        std::rethrow_exception(result);
+    }
+}
@@ -4,28 +4,94 @@
  * (using the array int example).
  */
 
+#include <algorithm>
 #include <chrono>
+#include <cmath>
+#include <fstream>
 #include <stdexcept>
-#include <random>
-#include <windows.h>
+#include <string>
+
+#ifdef __linux__
+#include <sched.h>
+#endif
 
 #include "sorter/time_meter.hpp"
 #include "sorter/sorter.hpp"
 #include "constants.hpp"
 
-std::mt19937 mersenne(static_cast<int>(time(0)));
+namespace {
+    // Current frequency of the processor in kHz from cpufreq,
+    // 0 if it is unknown.
+    long cpu_frequency(int cpu) {
+        std::ifstream file("/sys/devices/system/cpu/cpu" +
+                           std::to_string(cpu < 0 ? 0 : cpu) +
+                           "/cpufreq/scaling_cur_freq");
+        long frequency = 0;
+        if (!(file >> frequency)) return 0;
+        return frequency;
+    }
 
-// The function calculates the average interval length from several experiments.
+    // Pins the current thread to the processor for the time of the measurement
+    // and restores the previous processors in the destructor.
+    class CpuPinning {
+#ifdef __linux__
+        cpu_set_t previous;
+        bool pinned = false;
+#endif
+    public:
+        explicit CpuPinning(int cpu) {
+#ifdef __linux__
+            if ((cpu < 0) || (sched_getaffinity(0, sizeof(previous), &previous) != 0))
+                return;
+            cpu_set_t current;
+            CPU_ZERO(&current);
+            CPU_SET(cpu, &current);
+            pinned = sched_setaffinity(0, sizeof(current), &current) == 0;
+#else
+            (void)cpu;
+#endif
+        }
+        ~CpuPinning() {
+#ifdef __linux__
+            if (pinned) sched_setaffinity(0, sizeof(previous), &previous);
+#endif
+        }
+    };
+}
+
+// The constructor checks the number of experiments
+// and seeds the generator of the arrays.
+/// \param experiment_count - number of measured repetitions
+/// \param seed - seed of the generator of the arrays
+/// \param warmup_count - number of unmeasured repetitions before measuring
+/// \param cpu - processor for pinning, -1 - without pinning
+TimeMeter::TimeMeter(int experiment_count, unsigned seed, int warmup_count,
+                     int cpu)
+: experiment_count(experiment_count), seed(seed),
+warmup_count(warmup_count > 0 ? warmup_count : 0), cpu(cpu),
+generator(seed) {
+    if (experiment_count < const_time_meter::experiment_count_min)
+        throw std::invalid_argument(EXPERIMENT_COUNT_LOW_LIMIT_MESSAGE);
+    if (experiment_count > const_time_meter::experiment_count_limit)
+        throw std::invalid_argument(EXPERIMENT_COUNT_HIGH_LIMIT_MESSAGE);
+}
+
+// The function finds the first length of the array
+// which is sorted faster by quicksort than by inserts.
+// If inserts are faster for all lengths, length_limit is returned.
 /// \return the optimal length of the interval
 /// in which the sorter should use insertion sorting.
 int TimeMeter::experiment_with_array_count() {
     try {
+        generator.seed(seed);
         int optimal_length = 2;
-        while(true) {
+        while(optimal_length < const_time_meter::length_limit) {
             if (!is_for_insertion_sort(optimal_length)) return optimal_length - 1;
             optimal_length++;
         }
+        return const_time_meter::length_limit;
     }
+
     catch(std::exception &ex) {
         std::cerr << UNEXPECTED_EXP_MES << ex.what() << std::endl;
     }
@@ -33,50 +99,124 @@ int TimeMeter::experiment_with_array_count() {
 }
 
 // The function determine this size of arrays
-// is more suitable for sorting цшер штыукешщты.
+// is more suitable for sorting with insertions.
 /// \param size - size of the array
 /// \return - an array of this size is sorted faster by insertions
-bool TimeMeter::is_for_insertion_sort(int size) const {
-    int array[size];
-    for (auto i = 0; i < size; i++) array[i] = mersenne();
-    Sorter sorter(0);
-    sorter.sort(array, array + size, LESS(int));
-    double quick = 0, insert = 0;
-    for (auto i = 0; i < experiment_count; i++) {
-        auto start = std::chrono::high_resolution_clock::now();
-        sorter.simple_quicksort(array, array + size - 1, GREATER(int));
-        auto end = std::chrono::high_resolution_clock::now();
-        quick += std::chrono::duration<double>(end - start).count();
-
-        start = std::chrono::high_resolution_clock::now();
-        sorter.simple_insertion_sort(array, array + size - 1, LESS(int));
-        end = std::chrono::high_resolution_clock::now();
-        insert += std::chrono::duration<double>(end - start).count();
-    }
-    std::cout << "Size: " << size << " Time of quicksort: " << quick << " Time of insertion sort: " << insert << std::endl;
-    return insert <= quick;
+bool TimeMeter::is_for_insertion_sort(int size) {
+    MeasureStats quick, insert;
+    compare_sortings(size, quick, insert);
+    std::cout << "Size: " << size << " Time of quicksort: " << quick.median
+              << " Time of insertion sort: " << insert.median << std::endl;
+    return insert.median <= quick.median;
 }
 
-void TimeMeter::print_first_comparings(int count) const {
+// The function prints the times of both sortings
+// for the sizes of arrays from 2 to count + 1.
+/// \param count - number of sizes
+void TimeMeter::print_first_comparings(int count) {
+    generator.seed(seed);
     for (auto size = 2; size < count + 2; size++) {
-        int array[size];
-        for (auto i = 0; i < size; i++) array[i] = mersenne();
-        Sorter sorter(0);
-        sorter.sort(array, array + size, LESS(int));
-        double quick = 0, insert = 0;
-        for (auto i = 0; i < experiment_count; i++) {
-            auto start = std::chrono::high_resolution_clock::now();
-            sorter.simple_quicksort(array, array + size - 1, GREATER(int));
-            auto end = std::chrono::high_resolution_clock::now();
-            quick += std::chrono::duration<double>(end - start).count();
+        MeasureStats quick, insert;
+        compare_sortings(size, quick, insert);
+        std::cout << "Size: " << size
+                  << " Time of quicksort: " << quick.median
+                  << " (MAD " << quick.mad << ")"
+                  << " Time of insertion sort: " << insert.median
+                  << " (MAD " << insert.mad << ")"
+                  << ((quick.is_disturbed() || insert.is_disturbed()) ?
+                      " DISTURBED" : "") << std::endl;
+    }
+}
 
-            start = std::chrono::high_resolution_clock::now();
+// The function measures both sortings on the same random arrays:
+// batch_count arrays of the size are generated once and copied
+// before each repetition of both sortings.
+/// \param size - size of the arrays
+/// \param quick - statistics of quicksort
+/// \param insert - statistics of insertion sort
+void TimeMeter::compare_sortings(int size, MeasureStats &quick,
+                                 MeasureStats &insert) {
+    std::vector<int> source(static_cast<std::size_t>(size) *
+                            const_time_meter::batch_count), arrays;
+    Sorter sorter(0);
+    fill(source);
+    auto prepare = [&]() {arrays = source;};
+    quick = measure(prepare, [&]() {
+        for (auto array = arrays.data(); array < arrays.data() + arrays.size();
+             array += size)
+            sorter.simple_quicksort(array, array + size - 1, LESS(int));
+    });
+    insert = measure(prepare, [&]() {
+        for (auto array = arrays.data(); array < arrays.data() + arrays.size();
+             array += size)
             sorter.simple_insertion_sort(array, array + size - 1, LESS(int));
-            end = std::chrono::high_resolution_clock::now();
-            insert += std::chrono::duration<double>(end - start).count();
-        }
-        std::cout << "Size: " << size << " Time of quicksort: " << quick << " Time of insertion sort: " << insert
-                  << std::endl;
+    });
+}
+
+// The function fills the array by the generator.
+/// \param array - the array
+void TimeMeter::fill(std::vector<int> &array) {
+    for (auto &elem : array) elem = static_cast<int>(generator());
+}
+
+// The function measures the run: warmup_count unmeasured repetitions,
+// then experiment_count measured ones, prepare is called before each
+// repetition and is not measured.
+/// \param prepare - preparation of the data
+/// \param run - measured code
+/// \return - statistics of the repetitions
+MeasureStats TimeMeter::measure(const std::function<void()> &prepare,
+                                const std::function<void()> &run) {
+    CpuPinning pinning(cpu);
+    for (auto i = 0; i < warmup_count; i++) {
+        prepare();
+        run();
+    }
+    auto frequency_before = cpu_frequency(cpu);
+    std::vector<double> times;
+    for (auto i = 0; i < experiment_count; i++) {
+        prepare();
+        auto start = std::chrono::steady_clock::now();
+        run();
+        auto end = std::chrono::steady_clock::now();
+        times.push_back(std::chrono::duration<double>(end - start).count());
     }
+    auto frequency_after = cpu_frequency(cpu);
+    auto result = statistics(times);
+    if ((frequency_before > 0) && (frequency_after > 0))
+        result.frequency_changed =
+                std::abs(frequency_after - frequency_before) >
+                frequency_before * const_time_meter::frequency_tolerance;
+    return result;
 }
 
+// The function counts the median, the median absolute deviation
+// and the confidence interval of the median
+// by the order statistics n/2 -+ 1.96 * sqrt(n)/2.
+/// \param times - measured times
+/// \return - statistics of the times
+MeasureStats TimeMeter::statistics(std::vector<double> times) {
+    MeasureStats result;
+    result.repetitions = static_cast<int>(times.size());
+    if (times.empty()) return result;
+    auto median = [](std::vector<double> values) {
+        std::sort(values.begin(), values.end());
+        auto size = values.size();
+        return (size % 2) ? values[size / 2] :
+               (values[size / 2 - 1] + values[size / 2]) / 2;
+    };
+    result.median = median(times);
+    std::vector<double> deviations;
+    for (auto time : times) deviations.push_back(std::abs(time - result.median));
+    result.mad = median(deviations);
+
+    std::sort(times.begin(), times.end());
+    auto size = static_cast<double>(times.size());
+    auto half_width = 1.96 * std::sqrt(size) / 2;
+    auto low = static_cast<long>(std::floor(size / 2 - half_width));
+    auto high = static_cast<long>(std::ceil(size / 2 + half_width));
+    result.confidence_low = times[std::max<long>(low, 0)];
+    result.confidence_high = times[std::min<long>(high, times.size() - 1)];
+    result.noisy = result.mad > result.median * const_time_meter::noise_tolerance;
+    return result;
+}
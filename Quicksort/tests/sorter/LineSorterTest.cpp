@@ -0,0 +1,98 @@
+/**
+ * Tests for class LineSorter
+ * that sorts the lines of a text file by a delimited field.
+ * test_suit_names: LineSorterTest
+ * test_name: meaning + FUNCTION_NAME
+ */
+
+#include "gtest/gtest.h"
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <sorter/line_sorter.hpp>
+
+//
+// AUXILIARY FUNCTIONS
+//
+
+namespace {
+    // Joins the lines in the given order.
+    std::string getText(const std::vector<LineSorter::Line> &lines) {
+        std::string result;
+        for (const auto &line : lines) result += line.text;
+        return result;
+    }
+}
+
+//
+// TESTS
+//
+
+// The test checks the sorting by the field from the description of the class
+// with the keys longer than the cached prefix and the missing fields.
+TEST(LineSorterTest, KeyField_SORT_LINES) {
+    std::string text = "a,1,prefix_equal_2\n"
+                       "b,2,prefix_equal_1\n"
+                       "c,3\n"
+                       "d,4,abc\n"
+                       "e,5,ab\n";
+    LineSorter line_sorter(',', 3);
+
+    auto lines = line_sorter.sort_lines(text);
+
+    EXPECT_EQ(getText(lines), "c,3\n"
+                              "e,5,ab\n"
+                              "d,4,abc\n"
+                              "b,2,prefix_equal_1\n"
+                              "a,1,prefix_equal_2\n");
+    EXPECT_EQ(lines[1].key, "ab");
+}
+
+// The test checks that the lines with equal keys are ordered
+// by the whole lines whatever their order in the text.
+TEST(LineSorterTest, EqualKeys_SORT_LINES) {
+    LineSorter line_sorter(',', 2);
+
+    auto direct = getText(line_sorter.sort_lines("a,1\nc,1\nb,1\nd,0\n"));
+    auto reversed = getText(line_sorter.sort_lines("d,0\nb,1\nc,1\na,1\n"));
+
+    EXPECT_EQ(direct, "d,0\na,1\nb,1\nc,1\n");
+    EXPECT_EQ(reversed, direct);
+}
+
+// The test checks that the last line without '\n' and the empty text
+// are processed correctly.
+TEST(LineSorterTest, LastLineWithoutNewLine_SORT_LINES) {
+    LineSorter line_sorter;
+
+    EXPECT_TRUE(line_sorter.sort_lines("").empty());
+    EXPECT_EQ(getText(line_sorter.sort_lines("b\tx\na\ty")), "a\tyb\tx\n");
+}
+
+// The test checks that the sorted lines are written to the file
+// and each of them ends with '\n'.
+TEST(LineSorterTest, MappedFile_SORT_FILE) {
+    std::string input = ::testing::TempDir() + "line_sorter_input.txt";
+    std::ofstream(input) << "3 c\n1 a\n2 b";
+    auto output = std::tmpfile();
+    LineSorter line_sorter(' ', 2);
+
+    line_sorter.sort_file(input, fileno(output));
+
+    std::rewind(output);
+    char buffer[64] {};
+    auto length = std::fread(buffer, 1, sizeof(buffer), output);
+    std::fclose(output);
+    std::remove(input.c_str());
+    EXPECT_EQ(std::string(buffer, length), "1 a\n2 b\n3 c\n");
+}
+
+// The test checks the processing of the incorrect arguments.
+TEST(LineSorterTest, IncorrectArguments_EXCEPTION) {
+    EXPECT_THROW(LineSorter(',', 0), std::invalid_argument);
+    EXPECT_THROW(LineSorter().sort_file("/nonexistent/file.txt", 1),
+                 std::runtime_error);
+}
@@ -0,0 +1,160 @@
+/**
+ * Tests for class Merger
+ * that merges several sorted arrays with elements of an arbitrary type.
+ * test_suit_names: MergerTest
+ * test_name: meaning + FUNCTION_NAME
+ */
+
+#include "gtest/gtest.h"
+#include <algorithm>
+#include <random>
+#include <vector>
+
+#include "constants.hpp"
+#include <sorter/merger.hpp>
+
+//
+// AUXILIARY FUNCTIONS
+//
+
+namespace {
+    std::mt19937 merger_mersenne(20201218);
+
+    // Fills the array with sorted random numbers
+    // and returns the run for it.
+    SortedRun<int> getSortedRun(std::vector<int> &array, int size) {
+        array.resize(size);
+        for (auto &elem : array) elem = static_cast<int>(merger_mersenne() % 1000);
+        std::sort(array.begin(), array.end());
+        return {array.data(), array.data() + array.size()};
+    }
+}
+
+//
+// TESTS
+//
+
+// The test checks that the empty inputs give the empty output
+// and the output pointer is not used.
+TEST(MergerTest, EmptyRuns_MERGE) {
+    int a[] {1};
+    SortedRun<int> runs[] {{a, a}, {a, a}};
+    Merger merger;
+
+    EXPECT_NO_THROW(merger.merge(runs, runs + 2, (int *)nullptr, LESS(int)));
+    EXPECT_NO_THROW(merger.merge(runs, runs, (int *)nullptr, LESS(int)));
+}
+
+// The test checks the example from the description of the class
+// with inputs of different lengths.
+TEST(MergerTest, SmallRuns_MERGE) {
+    int a[] = {1, 4, 7}, b[] = {2, 5}, c[] = {3, 6};
+    SortedRun<int> runs[] = {{a, a + 3}, {b, b + 2}, {c, c + 2}};
+    int result[7];
+    Merger merger;
+
+    merger.merge(runs, runs + 3, result, LESS(int));
+
+    for (auto i = 0; i < 7; i++) EXPECT_EQ(result[i], i + 1);
+}
+
+// The test checks that the merge reads the inputs by blocks correctly
+// when the number of inputs is not a power of two
+// and some of the inputs are empty.
+TEST(MergerTest, ManyRunsSmallBlocks_MERGE) {
+    const auto count = 7;
+    std::vector<std::vector<int>> arrays(count);
+    std::vector<SortedRun<int>> runs;
+    std::vector<int> expected;
+    for (auto i = 0; i < count; i++) {
+        runs.push_back(getSortedRun(arrays[i], (i % 3 == 0) ? 0 : 100 + 37 * i));
+        expected.insert(expected.end(), arrays[i].begin(), arrays[i].end());
+    }
+    std::sort(expected.begin(), expected.end());
+    std::vector<int> result(expected.size());
+    Merger merger(3);
+
+    merger.merge(runs.data(), runs.data() + count, result.data(), LESS(int));
+
+    EXPECT_EQ(result, expected);
+}
+
+// The test checks that equal elements are taken in the order of the inputs.
+TEST(MergerTest, EqualElements_STABLE_MERGE) {
+    using Pair = std::pair<int, int>;
+    Pair a[] = {{1, 0}, {2, 0}, {2, 1}}, b[] = {{1, 2}, {2, 3}};
+    SortedRun<Pair> runs[] = {{a, a + 3}, {b, b + 2}};
+    Pair result[5];
+    Merger merger;
+
+    merger.merge(runs, runs + 2, result,
+                 [](const Pair &a, const Pair &b) {return a.first < b.first;});
+
+    EXPECT_EQ(result[0], Pair(1, 0));
+    EXPECT_EQ(result[1], Pair(1, 2));
+    EXPECT_EQ(result[2], Pair(2, 0));
+    EXPECT_EQ(result[3], Pair(2, 1));
+    EXPECT_EQ(result[4], Pair(2, 3));
+}
+
+// The test checks that the numbers of elements found by co-ranking
+// give the required position of the output
+// and do not separate the elements in the wrong order.
+TEST(MergerTest, PositionsOfOutput_SPLIT) {
+    std::vector<std::vector<int>> arrays(4);
+    std::vector<SortedRun<int>> runs;
+    long total = 0;
+    for (auto &array : arrays) {
+        runs.push_back(getSortedRun(array, 500));
+        total += 500;
+    }
+    Merger merger;
+    long borders[4];
+
+    for (long position = 0; position <= total; position += 97) {
+        merger.split(runs.data(), runs.data() + 4, position, borders, LESS(int));
+        long sum = 0;
+        for (auto i = 0; i < 4; i++) sum += borders[i];
+        EXPECT_EQ(sum, position);
+        for (auto i = 0; i < 4; i++)
+            for (auto j = 0; j < 4; j++)
+                if ((borders[i] > 0) && (borders[j] < runs[j].size())) {
+                    EXPECT_LE(runs[i].first[borders[i] - 1],
+                              runs[j].first[borders[j]]);
+                }
+    }
+}
+
+// The test checks that the parallel merge gives the same output
+// as the sequential one.
+TEST(MergerTest, ParallelEqualsSequential_MERGE) {
+    const auto count = 5;
+    std::vector<std::vector<int>> arrays(count);
+    std::vector<SortedRun<int>> runs;
+    for (auto &array : arrays)
+        runs.push_back(getSortedRun(array, const_merge::parallel_min_len / 2));
+    std::vector<int> sequential(count * (const_merge::parallel_min_len / 2)),
+            parallel(sequential.size());
+
+    Merger(const_merge::block_len, 1).merge(
+            runs.data(), runs.data() + count, sequential.data(), LESS(int));
+    Merger(const_merge::block_len, 4).merge(
+            runs.data(), runs.data() + count, parallel.data(), LESS(int));
+
+    EXPECT_TRUE(std::is_sorted(sequential.begin(), sequential.end()));
+    EXPECT_EQ(parallel, sequential);
+}
+
+// The test checks the processing of the incorrect inputs.
+TEST(MergerTest, IncorrectRuns_EXCEPTION) {
+    int a[] {1, 2};
+    SortedRun<int> runs[] {{a + 2, a}};
+    int result[2];
+    Merger merger;
+
+    EXPECT_THROW(merger.merge(runs, runs + 1, result, LESS(int)),
+                 std::invalid_argument);
+    EXPECT_THROW(
+            merger.merge((SortedRun<int> *)nullptr, runs, result, LESS(int)),
+                 std::invalid_argument);
+}
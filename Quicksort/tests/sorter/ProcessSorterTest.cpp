@@ -0,0 +1,101 @@
+/**
+ * Tests for class ProcessSorter
+ * that sorts an array in shared memory by several processes.
+ * test_suit_names: ProcessSorterTest
+ * test_name: meaning + FUNCTION_NAME
+ */
+
+#include "gtest/gtest.h"
+#include <algorithm>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <unistd.h>
+
+#include "constants.hpp"
+#include <sorter/process_sorter.hpp>
+
+//
+// AUXILIARY FUNCTIONS
+//
+
+namespace {
+    std::mt19937 process_mersenne(20201218);
+
+    // Unique name of the shared memory segment for the test.
+    std::string getSegmentName(const std::string &test) {
+        return "/quicksort_" + test + "_" + std::to_string(getpid());
+    }
+}
+
+//
+// TESTS
+//
+
+// The test checks that the large array in the segment is sorted
+// by several processes as by std::sort.
+TEST(ProcessSorterTest, LargeArray_SORT) {
+    const long size = 8 * const_sort::process_len + 123;
+    SharedSegment segment(getSegmentName("large"), size * sizeof(int));
+    auto array = segment.as<int>();
+    for (long i = 0; i < size; i++) array[i] = static_cast<int>(process_mersenne() % 100000);
+    std::vector<int> expected(array, array + size);
+    std::sort(expected.begin(), expected.end(), GREATER(int));
+
+    ProcessSorter(4).sort(array, array + size, GREATER(int));
+
+    EXPECT_EQ(std::vector<int>(array, array + size), expected);
+}
+
+// The test checks that the array sorted through one mapping of the segment
+// is seen through another mapping of it by the name,
+// and that many equal elements do not stop the partitions.
+TEST(ProcessSorterTest, OpenedSegmentEqualElements_SORT) {
+    const long size = 4 * const_sort::process_len;
+    SharedSegment created(getSegmentName("opened"), size * sizeof(long));
+    SharedSegment opened(getSegmentName("opened"));
+    auto array = created.as<long>();
+    for (long i = 0; i < size; i++) array[i] = static_cast<long>(process_mersenne() % 3);
+
+    ProcessSorter(3).sort(array, array + size, LESS(long));
+
+    ASSERT_EQ(opened.size(), created.size());
+    EXPECT_TRUE(std::is_sorted(opened.as<long>(), opened.as<long>() + size));
+}
+
+// The test checks that the short array and the sorting by one process
+// do not need the processes.
+TEST(ProcessSorterTest, ShortArrayOneProcess_SORT) {
+    std::vector<int> a {5, 3, 1, 4, 2};
+
+    ProcessSorter(4).sort(a.data(), a.data() + a.size(), LESS(int));
+
+    EXPECT_EQ(a, std::vector<int>({1, 2, 3, 4, 5}));
+    EXPECT_EQ(ProcessSorter(1).size(), 1);
+    EXPECT_GE(ProcessSorter().size(), 1);
+}
+
+// The test checks that the large array outside the shared memory
+// is sorted by the current process instead of the private copies.
+TEST(ProcessSorterTest, PrivateMemory_SORT) {
+    std::vector<int> a(2 * const_sort::process_len);
+    for (auto &elem : a) elem = static_cast<int>(process_mersenne() % 100000);
+    auto expected = a;
+    std::sort(expected.begin(), expected.end());
+
+    ProcessSorter(4).sort(a.data(), a.data() + a.size(), LESS(int));
+
+    EXPECT_EQ(a, expected);
+}
+
+// The test checks the processing of the incorrect arguments.
+TEST(ProcessSorterTest, IncorrectArguments_EXCEPTION) {
+    int a[] {1, 2};
+    ProcessSorter process_sorter(2);
+
+    EXPECT_THROW(process_sorter.sort(a + 2, a, LESS(int)), std::invalid_argument);
+    EXPECT_THROW(process_sorter.sort((int *)nullptr, a, LESS(int)),
+                 std::invalid_argument);
+    EXPECT_THROW(SharedSegment("/quicksort_missing_segment"), std::runtime_error);
+}
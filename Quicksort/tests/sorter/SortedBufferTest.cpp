@@ -0,0 +1,94 @@
+/**
+ * Tests for class SortedBuffer
+ * that keeps appended values of an arbitrary type for reading in sorted order.
+ * test_suit_names: SortedBufferTest
+ * test_name: meaning + FUNCTION_NAME
+ */
+
+#include "gtest/gtest.h"
+#include <algorithm>
+#include <random>
+#include <vector>
+
+#include "constants.hpp"
+#include <sorter/sorted_buffer.hpp>
+
+//
+// AUXILIARY FUNCTIONS
+//
+
+namespace {
+    std::mt19937 buffer_mersenne(20201218);
+
+    template<typename T, typename Compare>
+    std::vector<T> readAll(SortedBuffer<T, Compare> &buffer) {
+        std::vector<T> result;
+        for (auto it = buffer.iterator(); !it.isEnd(); it.next())
+            result.push_back(it.get());
+        return result;
+    }
+}
+
+//
+// TESTS
+//
+
+// The test checks that the empty buffer is read without values.
+TEST(SortedBufferTest, EmptyBuffer_ITERATOR) {
+    SortedBuffer<int> buffer;
+
+    EXPECT_TRUE(buffer.iterator().isEnd());
+    EXPECT_EQ(buffer.sorted().first, buffer.sorted().second);
+    EXPECT_EQ(buffer.size(), 0u);
+}
+
+// The test checks that the values appended between the readings
+// are read in sorted order together with the old ones.
+TEST(SortedBufferTest, AppendBetweenReadings_ITERATOR) {
+    auto comp = GREATER(int);
+    SortedBuffer<int, decltype(comp)> buffer(comp, 4);
+    std::vector<int> expected;
+    for (auto step = 0; step < 5; step++) {
+        for (auto i = 0; i < 7; i++) {
+            auto value = static_cast<int>(buffer_mersenne() % 100);
+            buffer.insert(value);
+            expected.push_back(value);
+        }
+        std::sort(expected.begin(), expected.end(), comp);
+
+        EXPECT_EQ(readAll(buffer), expected);
+    }
+    EXPECT_EQ(buffer.size(), expected.size());
+}
+
+// The test checks that the runs of close sizes are merged
+// and the number of runs grows logarithmically.
+TEST(SortedBufferTest, ManyBatches_FLUSH) {
+    const std::size_t batch = 8, count = 1 << 12;
+    SortedBuffer<int> buffer(std::less<int>(), batch);
+    for (std::size_t i = 0; i < count; i++)
+        buffer.insert(static_cast<int>(buffer_mersenne()));
+    buffer.flush();
+
+    EXPECT_LE(buffer.runCount(), 10u);
+    auto values = readAll(buffer);
+    EXPECT_EQ(values.size(), count);
+    EXPECT_TRUE(std::is_sorted(values.begin(), values.end()));
+}
+
+// The test checks that all runs are merged into one sorted array
+// and the buffer stays correct after that.
+TEST(SortedBufferTest, MergeAllRuns_SORTED) {
+    SortedBuffer<int> buffer(std::less<int>(), 3);
+    for (auto i = 20; i > 0; i--) buffer.insert(i);
+
+    auto range = buffer.sorted();
+
+    EXPECT_EQ(range.second - range.first, 20);
+    EXPECT_EQ(buffer.runCount(), 1u);
+    for (auto i = 0; i < 20; i++) EXPECT_EQ(range.first[i], i + 1);
+    buffer.insert(0);
+    EXPECT_EQ(readAll(buffer).front(), 0);
+    buffer.clear();
+    EXPECT_TRUE(buffer.iterator().isEnd());
+}
@@ -1,7 +1,10 @@
 /**
  * Tests for class Sorter
  * that sorts an array with elements of an arbitrary type.
- * test_suit_names: SorterTest, PrintTest, ExceptionsTest, TimeMeterTest
+ * test_suit_names: SorterTest, PrintTest, ExceptionsTest, TimeMeterTest,
+ * PolicySorterTest, AsyncSorterTest, TotalOrderSorterTest, ColumnsSorterTest,
+ * CacheTiledSorterTest, PresortedSorterTest, SmallRangeSorterTest,
+ * UniqueSorterTest, BinaryInsertionSorterTest, StatsSorterTest
  * test_name: meaning + FUNCTION_NAME
  *
  *
@@ -12,8 +15,15 @@
  */
 
 #include "gtest/gtest.h"
+#include <algorithm>
+#include <chrono>
+#include <execution>
 #include <random>
 #include <ctime>
+#include <cmath>
+#include <limits>
+#include <stop_token>
+#include <vector>
 
 #include "constants.hpp"
 #include <sorter/sorter.hpp>
@@ -33,6 +43,19 @@ public:
     ~TestClass() {std::cout << TEST_DESTRUCTOR_MESSAGE;}
 };
 
+// Fake clock for the calibration: the time goes only by the ticks
+// added by the tested predicate.
+struct TickClock {
+    using rep = long;
+    using period = std::nano;
+    using duration = std::chrono::duration<rep, period>;
+    using time_point = std::chrono::time_point<TickClock>;
+    static constexpr bool is_steady = true;
+    static inline rep ticks = 0;
+
+    static time_point now() {return time_point(duration(ticks));}
+};
+
 //
 // AUXILIARY FUNCTIONS
 //
@@ -280,4 +303,859 @@ TEST(SorterTest, SortArrayGreater_SIMPLEINSRTIONSORT) {
     sorter.print(a, a + size);
 
     EXPECT_TRUE(isSortedArray(a, a + size, GREATER_OR_EQUAL(long)));
-}
\ No newline at end of file
+}
+
+/*
+ * Tests on sorting with execution policies
+ */
+
+// The test checks that all policies sort a large array
+// (longer than the interval sent to other threads) in the same way.
+TEST(PolicySorterTest, LargeArrayAllPolicies_SORT) {
+    const auto size = 8 * const_sort::parallel_len;
+    std::vector<int> expected(size);
+    for (auto &elem : expected) elem = mersenne();
+    auto seq = expected, par = expected, par_unseq = expected,
+            unseq = expected;
+    std::sort(expected.begin(), expected.end());
+
+    sorter.sort(std::execution::seq, seq.data(), seq.data() + size, LESS(int));
+    sorter.sort(std::execution::par, par.data(), par.data() + size, LESS(int));
+    sorter.sort(std::execution::par_unseq, par_unseq.data(),
+                par_unseq.data() + size, LESS(int));
+    sorter.sort(std::execution::unseq, unseq.data(), unseq.data() + size,
+                LESS(int));
+
+    EXPECT_EQ(seq, expected);
+    EXPECT_EQ(par, expected);
+    EXPECT_EQ(par_unseq, expected);
+    EXPECT_EQ(unseq, expected);
+}
+
+// The test checks that the branchless partition does not degrade
+// on an array with few distinct values (Lomuto scheme is quadratic on them).
+TEST(PolicySorterTest, ManyEqualElements_PAR_UNSEQ_SORT) {
+    const auto size = 4 * const_sort::parallel_len;
+    std::vector<long> a(size);
+    for (auto &elem : a) elem = mersenne() % 3;
+
+    sorter.sort(std::execution::par_unseq, a.data(), a.data() + size,
+                GREATER(long));
+
+    EXPECT_TRUE(std::is_sorted(a.begin(), a.end(), GREATER(long)));
+}
+
+// The test checks that the parallel sorting of a type with constructors
+// uses the usual partition and keeps the values.
+TEST(PolicySorterTest, ComplexType_PAR_SORT) {
+    const auto size = 2 * const_sort::parallel_len;
+    std::vector<std::string> a(size);
+    for (auto &elem : a) elem = std::to_string(mersenne() % 1000);
+    auto expected = a;
+    std::sort(expected.begin(), expected.end());
+
+    sorter.sort(std::execution::par_unseq, a.data(), a.data() + size,
+                [](const std::string &a, const std::string &b) {return a < b;});
+
+    EXPECT_EQ(a, expected);
+}
+
+// The test checks the processing of an empty and a single-element array
+// with the parallel policy.
+TEST(PolicySorterTest, EmptyAndOneElement_PAR_SORT) {
+    int a[] {5};
+
+    sorter.sort(std::execution::par, a, a, LESS(int));
+    sorter.sort(std::execution::par, a, a + 1, LESS(int));
+
+    EXPECT_EQ(a[0], 5);
+}
+
+/*
+ * Tests on the background sorting
+ */
+
+// The test checks that the background sorting gives the sorted array
+// and the whole progress.
+TEST(AsyncSorterTest, LargeArray_SORT_ASYNC) {
+    const auto size = 1 << 16;
+    std::vector<int> a(size);
+    for (auto &elem : a) elem = mersenne();
+
+    auto task = sorter.sort_async(a.data(), a.data() + size, LESS(int));
+
+    EXPECT_TRUE(task.get());
+    EXPECT_DOUBLE_EQ(task.progress(), 1.0);
+    EXPECT_TRUE(std::is_sorted(a.begin(), a.end()));
+}
+
+// The test checks that the sorting cancelled by the external token
+// before the start keeps all elements of the array.
+TEST(AsyncSorterTest, CancelledByToken_SORT_ASYNC) {
+    const auto size = 1 << 16;
+    std::vector<int> a(size);
+    for (auto &elem : a) elem = mersenne();
+    auto expected = a;
+    std::sort(expected.begin(), expected.end());
+    std::stop_source source;
+    source.request_stop();
+
+    auto task = sorter.sort_async(a.data(), a.data() + size, LESS(int),
+                                  source.get_token());
+
+    EXPECT_FALSE(task.get());
+    EXPECT_LT(task.progress(), 1.0);
+    std::sort(a.begin(), a.end());
+    EXPECT_EQ(a, expected);
+}
+
+// The test checks that the task can be cancelled during the sorting
+// and the destructor waits for the thread.
+TEST(AsyncSorterTest, CancelAndDestroy_SORT_ASYNC) {
+    const auto size = 1 << 20;
+    std::vector<long> a(size);
+    for (auto &elem : a) elem = mersenne();
+    {
+        auto task = sorter.sort_async(a.data(), a.data() + size,
+                                      GREATER(long));
+        task.cancel();
+        auto progress = task.progress();
+        EXPECT_GE(progress, 0.0);
+        EXPECT_LE(progress, 1.0);
+    }
+    auto task = sorter.sort_async(a.data(), a.data() + size, GREATER(long));
+    while (task.wait_for(std::chrono::milliseconds(1)) !=
+           std::future_status::ready)
+        EXPECT_LE(task.progress(), 1.0);
+    EXPECT_TRUE(task.get());
+    EXPECT_TRUE(std::is_sorted(a.begin(), a.end(), GREATER(long)));
+}
+
+// The test checks that more sortings than the threads of the executor
+// wait in its queue and all of them are finished.
+TEST(AsyncSorterTest, ManyTasks_SORT_ASYNC) {
+    const auto count = 4 * const_sort::async_thread_count, size = 1u << 12;
+    std::vector<std::vector<int>> arrays(count, std::vector<int>(size));
+    std::vector<SortTask> tasks;
+    for (auto &array : arrays) {
+        for (auto &elem : array) elem = mersenne();
+        tasks.push_back(sorter.sort_async(array.data(), array.data() + size,
+                                          LESS(int)));
+    }
+
+    for (auto &task : tasks) EXPECT_TRUE(task.get());
+    for (auto &array : arrays) EXPECT_TRUE(std::is_sorted(array.begin(), array.end()));
+}
+
+// The test checks the background sorting of an empty array.
+TEST(AsyncSorterTest, EmptyArray_SORT_ASYNC) {
+    int a[] {1};
+
+    auto task = sorter.sort_async(a, a, LESS(int));
+
+    EXPECT_TRUE(task.get());
+    EXPECT_DOUBLE_EQ(task.progress(), 1.0);
+}
+
+/*
+ * Tests on sorting floating-point numbers in the total order
+ */
+
+// The test checks the places of NaNs, infinities and zeros with signs.
+TEST(TotalOrderSorterTest, SpecialValues_SORT_TOTAL_ORDER) {
+    const auto nan = std::numeric_limits<double>::quiet_NaN();
+    const auto inf = std::numeric_limits<double>::infinity();
+    double a[] {nan, 1.5, -0.0, -nan, 0.0, -inf, inf, -2.0, 0.0, nan};
+
+    sorter.sort_total_order(a, a + 10);
+
+    EXPECT_EQ(a[0], -inf);
+    EXPECT_EQ(a[1], -2.0);
+    EXPECT_TRUE((a[2] == 0.0) && std::signbit(a[2]));
+    EXPECT_TRUE((a[3] == 0.0) && !std::signbit(a[3]));
+    EXPECT_TRUE((a[4] == 0.0) && !std::signbit(a[4]));
+    EXPECT_EQ(a[5], 1.5);
+    EXPECT_EQ(a[6], inf);
+    EXPECT_TRUE(std::isnan(a[7]) && std::signbit(a[7]));
+    EXPECT_TRUE(std::isnan(a[8]) && !std::signbit(a[8]));
+    EXPECT_TRUE(std::isnan(a[9]) && !std::signbit(a[9]));
+}
+
+// The test checks that without moving NaNs
+// the order is IEEE 754 totalOrder: -NaN first and +NaN last.
+TEST(TotalOrderSorterTest, NaNsAtEnds_SORT_TOTAL_ORDER) {
+    const auto nan = std::numeric_limits<float>::quiet_NaN();
+    float a[] {nan, 3.0f, -nan, -1.0f};
+
+    sorter.sort_total_order(a, a + 4, false);
+
+    EXPECT_TRUE(std::isnan(a[0]) && std::signbit(a[0]));
+    EXPECT_EQ(a[1], -1.0f);
+    EXPECT_EQ(a[2], 3.0f);
+    EXPECT_TRUE(std::isnan(a[3]) && !std::signbit(a[3]));
+}
+
+// The test checks that the radix sort of a large array with NaNs
+// gives the same order as the comparison sorting with TOTAL_ORDER_LESS.
+TEST(TotalOrderSorterTest, LargeArrayWithNaNs_SORT_TOTAL_ORDER) {
+    const auto size = 10 * const_sort::radix_len;
+    std::vector<double> a(size);
+    std::uniform_real_distribution<double> distribution(-1e6, 1e6);
+    for (auto &elem : a)
+        elem = (mersenne() % 50 == 0) ?
+                std::numeric_limits<double>::quiet_NaN() : distribution(mersenne);
+    auto expected = a;
+    std::sort(expected.begin(), expected.end(), TOTAL_ORDER_LESS(double));
+
+    sorter.sort_total_order(a.data(), a.data() + size);
+
+    EXPECT_EQ(memcmp(a.data(), expected.data(), size * sizeof(double)), 0);
+}
+
+/*
+ * Tests on sorting the columns
+ */
+
+// The test checks the example from the description of the function:
+// payloads of different types follow their keys.
+TEST(ColumnsSorterTest, SmallColumns_SORT_COLUMNS) {
+    int keys[] = {3, 1, 2};
+    double prices[] = {0.3, 0.1, 0.2};
+    std::string names[] = {"c", "a", "b"};
+
+    sorter.sort_columns(keys, keys + 3, LESS(int), prices, names);
+
+    EXPECT_EQ(keys[0], 1);
+    EXPECT_EQ(keys[2], 3);
+    EXPECT_EQ(prices[0], 0.1);
+    EXPECT_EQ(prices[2], 0.3);
+    EXPECT_EQ(names[0], "a");
+    EXPECT_EQ(names[2], "c");
+}
+
+// The test checks that the rows of the large columns stay together
+// after sorting with equal keys.
+TEST(ColumnsSorterTest, LargeColumns_SORT_COLUMNS) {
+    const auto size = 1 << 14;
+    std::vector<long> keys(size), rows(size);
+    std::vector<std::string> names(size);
+    for (auto i = 0; i < size; i++) {
+        keys[i] = mersenne() % 1000;
+        rows[i] = keys[i] * size + i;
+        names[i] = std::to_string(rows[i]);
+    }
+
+    sorter.sort_columns(keys.data(), keys.data() + size, GREATER(long),
+                        rows.data(), names.data());
+
+    EXPECT_TRUE(std::is_sorted(keys.begin(), keys.end(), GREATER(long)));
+    for (auto i = 0; i < size; i++) {
+        EXPECT_EQ(rows[i] / size, keys[i]);
+        EXPECT_EQ(names[i], std::to_string(rows[i]));
+    }
+}
+
+// The test checks that the exception of the predicate
+// leaves the keys and the payloads unchanged.
+TEST(ColumnsSorterTest, ThrowingComparison_SORT_COLUMNS) {
+    const auto size = 1000;
+    std::vector<std::string> keys(size), expected_keys;
+    std::vector<int> rows(size);
+    for (auto i = 0; i < size; i++) {
+        keys[i] = std::to_string(mersenne());
+        rows[i] = i;
+    }
+    expected_keys = keys;
+    auto calls = 0;
+
+    sorter.sort_columns(keys.data(), keys.data() + size,
+                        [&calls](const std::string &a, const std::string &b) {
+        if (++calls == size) throw std::runtime_error("comparison");
+        return a < b;
+    }, rows.data());
+
+    EXPECT_EQ(keys, expected_keys);
+    for (auto i = 0; i < size; i++) EXPECT_EQ(rows[i], i);
+}
+
+// The test checks that only keys are sorted without payloads
+// and the array from a single element is not changed.
+TEST(ColumnsSorterTest, WithoutPayloads_SORT_COLUMNS) {
+    int keys[] = {2, 1};
+    double payload[] = {2.0};
+
+    sorter.sort_columns(keys, keys + 2, LESS(int));
+    sorter.sort_columns(keys, keys + 1, LESS(int), payload);
+
+    EXPECT_EQ(keys[0], 1);
+    EXPECT_EQ(keys[1], 2);
+    EXPECT_EQ(payload[0], 2.0);
+}
+
+/*
+ * Tests on sorting by blocks in the cache
+ */
+
+// The test checks that the array of several blocks
+// with more blocks than merged at a time is sorted.
+TEST(CacheTiledSorterTest, ManyBlocks_SORT_CACHE_TILED) {
+    Sorter small_leaf_sorter(4);
+    const auto block_length = 64L;
+    const auto size = block_length * (const_sort::merge_fan_in + 3) + 5;
+    std::vector<char> a(size);
+    for (auto &elem : a) elem = static_cast<char>(mersenne());
+
+    small_leaf_sorter.sort_cache_tiled(a.data(), a.data() + size, LESS(char),
+                                       block_length);
+
+    EXPECT_TRUE(std::is_sorted(a.begin(), a.end()));
+}
+
+// The test checks that the array of a single block
+// with constructors is sorted in place.
+TEST(CacheTiledSorterTest, ComplexTypeOneBlock_SORT_CACHE_TILED) {
+    std::vector<std::string> a(100);
+    for (auto &elem : a) elem = std::to_string(mersenne());
+    auto expected = a;
+    std::sort(expected.begin(), expected.end(), GREATER(std::string));
+
+    sorter.sort_cache_tiled(a.data(), a.data() + a.size(),
+                            GREATER(std::string));
+
+    EXPECT_EQ(a, expected);
+}
+
+// The test checks that the array of several blocks
+// with constructors is sorted and no element is lost by moving.
+TEST(CacheTiledSorterTest, ComplexTypeManyBlocks_SORT_CACHE_TILED) {
+    const auto block_length = 50L;
+    std::vector<std::string> a(block_length * 3 + 7);
+    for (auto &elem : a) elem = std::to_string(mersenne());
+    auto expected = a;
+    std::sort(expected.begin(), expected.end(), LESS(std::string));
+
+    sorter.sort_cache_tiled(a.data(), a.data() + a.size(), LESS(std::string),
+                            block_length);
+
+    EXPECT_EQ(a, expected);
+}
+
+/*
+ * Tests on sorting presorted arrays
+ */
+
+// The test checks that the sorted array is not changed
+// and the comparator is called only for the scan.
+TEST(PresortedSorterTest, SortedArray_SORT) {
+    const auto size = 1000;
+    std::vector<int> a(size);
+    for (auto i = 0; i < size; i++) a[i] = i / 3;
+    auto expected = a;
+    long calls = 0;
+
+    sorter.sort(a.data(), a.data() + size,
+                [&calls](int a, int b) {calls++; return a < b;});
+
+    EXPECT_EQ(a, expected);
+    EXPECT_LE(calls, 2 * size);
+}
+
+// The test checks that the array in reverse order (with equal elements)
+// is reversed in place.
+TEST(PresortedSorterTest, ReversedArray_SORT) {
+    const auto size = 1000;
+    std::vector<int> a(size);
+    for (auto i = 0; i < size; i++) a[i] = (size - i) / 2;
+    long calls = 0;
+
+    sorter.sort(a.data(), a.data() + size,
+                [&calls](int a, int b) {calls++; return a < b;});
+
+    EXPECT_TRUE(std::is_sorted(a.begin(), a.end()));
+    EXPECT_LE(calls, 2 * size);
+}
+
+// The test checks that the array of several ascending and descending runs
+// is merged correctly.
+TEST(PresortedSorterTest, FewRuns_SORT) {
+    std::vector<std::string> a;
+    for (auto run = 0; run < 5; run++) {
+        std::vector<std::string> part(200 + run);
+        for (auto &elem : part) elem = std::to_string(mersenne() % 1000);
+        if (run % 2 == 0) std::sort(part.begin(), part.end());
+        else std::sort(part.begin(), part.end(), GREATER(std::string));
+        a.insert(a.end(), part.begin(), part.end());
+    }
+    auto expected = a;
+    std::sort(expected.begin(), expected.end());
+
+    sorter.sort(a.data(), a.data() + a.size(), LESS(std::string));
+
+    EXPECT_EQ(a, expected);
+}
+
+// The test checks that the array of several runs keeps all elements
+// if the predicate throws while the runs are merged.
+TEST(PresortedSorterTest, ThrowingComparisonInMerge_SORT) {
+    std::vector<std::string> a;
+    for (auto run = 0; run < 3; run++) {
+        std::vector<std::string> part(200);
+        for (auto &elem : part) elem = std::to_string(mersenne() % 1000);
+        std::sort(part.begin(), part.end());
+        a.insert(a.end(), part.begin(), part.end());
+    }
+    auto expected = a;
+    std::sort(expected.begin(), expected.end());
+    auto calls = 0;
+
+    ::testing::internal::CaptureStderr();
+    sorter.sort(a.data(), a.data() + a.size(),
+                [&calls](const std::string &a, const std::string &b) {
+        if (++calls == 2 * 600 + 100) throw std::runtime_error("comparison");
+        return a < b;
+    });
+    ::testing::internal::GetCapturedStderr();
+
+    EXPECT_GT(calls, 2 * 600);
+    std::sort(a.begin(), a.end());
+    EXPECT_EQ(a, expected);
+}
+
+// The test checks that the array with many runs after a long sorted prefix
+// is sorted by quicksort.
+TEST(PresortedSorterTest, ManyRuns_SORT) {
+    const auto size = 5000;
+    std::vector<long> a(size);
+    for (auto i = 0; i < size; i++)
+        a[i] = (i < size / 2) ? i : static_cast<long>(mersenne() % size);
+
+    sorter.sort(a.data(), a.data() + size, LESS(long));
+
+    EXPECT_TRUE(std::is_sorted(a.begin(), a.end()));
+}
+
+/*
+ * Tests on sorting integers of a small range by counting
+ */
+
+// The test checks that the negative numbers of a small range
+// are sorted by counting with the found range.
+TEST(SmallRangeSorterTest, NegativeValues_SORT_SMALL_RANGE) {
+    const auto size = 1000;
+    std::vector<short> a(size);
+    for (auto &elem : a) elem = static_cast<short>(mersenne() % 100) - 50;
+    auto expected = a;
+    std::sort(expected.begin(), expected.end());
+
+    sorter.sort_small_range(a.data(), a.data() + size);
+
+    EXPECT_EQ(a, expected);
+}
+
+// The test checks that the values of a large range
+// (including the limits of the type) are sorted by quicksort.
+TEST(SmallRangeSorterTest, LargeRange_SORT_SMALL_RANGE) {
+    const auto size = 1000;
+    std::vector<int> a(size);
+    for (auto &elem : a) elem = mersenne();
+    a[10] = std::numeric_limits<int>::min();
+    a[20] = std::numeric_limits<int>::max();
+    auto expected = a;
+    std::sort(expected.begin(), expected.end());
+
+    sorter.sort_small_range(a.data(), a.data() + size);
+
+    EXPECT_EQ(a, expected);
+}
+
+// The test checks that the values covering the whole 64-bit type
+// are sorted by quicksort and the range given for them is rejected.
+TEST(SmallRangeSorterTest, FullRange64_SORT_SMALL_RANGE) {
+    long long a[] {std::numeric_limits<long long>::max(), 3,
+                   std::numeric_limits<long long>::min(), 5};
+    unsigned long long b[] {std::numeric_limits<unsigned long long>::max(), 3, 0};
+
+    sorter.sort_small_range(a, a + 4);
+    ::testing::internal::CaptureStderr();
+    sorter.sort_small_range(b, b + 3, KeyRange<unsigned long long>{
+            0, std::numeric_limits<unsigned long long>::max()});
+    std::string error_message = ::testing::internal::GetCapturedStderr();
+
+    EXPECT_EQ(a[0], std::numeric_limits<long long>::min());
+    EXPECT_EQ(a[1], 3);
+    EXPECT_EQ(a[2], 5);
+    EXPECT_EQ(a[3], std::numeric_limits<long long>::max());
+    EXPECT_NE(error_message.find(ILLEGAL_ARG_RANGE_EXC_MESSAGE),
+              std::string::npos);
+    EXPECT_EQ(b[1], 3);
+}
+
+// The test checks sorting with the range given by the caller
+// and that values outside of it are reported without losing elements.
+TEST(SmallRangeSorterTest, RangeHint_SORT_SMALL_RANGE) {
+    unsigned char a[] {200, 7, 255, 0, 7};
+    unsigned char b[] {3, 9, 1};
+
+    sorter.sort_small_range(a, a + 5, KeyRange<unsigned char>{0, 255});
+    ::testing::internal::CaptureStderr();
+    sorter.sort_small_range(b, b + 3, KeyRange<unsigned char>{0, 5});
+    std::string error_message = ::testing::internal::GetCapturedStderr();
+
+    EXPECT_EQ(a[0], 0);
+    EXPECT_EQ(a[1], 7);
+    EXPECT_EQ(a[2], 7);
+    EXPECT_EQ(a[3], 200);
+    EXPECT_EQ(a[4], 255);
+    EXPECT_NE(error_message.find(ILLEGAL_ARG_RANGE_EXC_MESSAGE),
+              std::string::npos);
+    EXPECT_EQ(b[0] + b[1] + b[2], 13);
+}
+
+// The test checks that values with equal keys keep their order
+// both for counting and for the large range of keys.
+TEST(SmallRangeSorterTest, StableValues_SORT_SMALL_RANGE_BY_KEY) {
+    for (auto range : {10u, 1000000000u}) {
+        const auto size = 2000;
+        std::vector<unsigned> keys(size);
+        std::vector<std::string> values(size);
+        for (auto i = 0; i < size; i++) {
+            keys[i] = mersenne() % range;
+            values[i] = std::to_string(keys[i]) + "_" + std::to_string(i);
+        }
+
+        sorter.sort_small_range_by_key(keys.data(), keys.data() + size,
+                                       values.data());
+
+        EXPECT_TRUE(std::is_sorted(keys.begin(), keys.end()));
+        for (auto i = 1; i < size; i++) {
+            EXPECT_EQ(values[i].substr(0, values[i].find('_')),
+                      std::to_string(keys[i]));
+            if (keys[i] == keys[i - 1]) {
+                EXPECT_LT(std::stoi(values[i - 1].substr(values[i - 1].find('_') + 1)),
+                          std::stoi(values[i].substr(values[i].find('_') + 1)));
+            }
+        }
+    }
+}
+
+// The test checks that the large array is counted by parts in parallel
+// and the values with equal keys keep their order.
+TEST(SmallRangeSorterTest, ParallelHistogram_SORT_SMALL_RANGE_BY_KEY) {
+    const auto size = const_sort::counting_parallel_len + 123;
+    std::vector<int> keys(size), values(size);
+    for (auto i = 0; i < size; i++) {
+        keys[i] = static_cast<int>(mersenne() % 1000);
+        values[i] = i;
+    }
+    auto plain = keys;
+
+    sorter.sort_small_range_by_key(keys.data(), keys.data() + size,
+                                   values.data(), KeyRange<int>{0, 999});
+    sorter.sort_small_range(plain.data(), plain.data() + size);
+
+    EXPECT_EQ(plain, keys);
+    EXPECT_TRUE(std::is_sorted(keys.begin(), keys.end()));
+    for (auto i = 1; i < size; i++) {
+        if (keys[i] == keys[i - 1]) {
+            EXPECT_LT(values[i - 1], values[i]);
+        }
+    }
+}
+
+/*
+ * Tests on sorting with removing equal elements
+ */
+
+// The test checks the example from the description of the function.
+TEST(UniqueSorterTest, SmallArray_SORT_UNIQUE) {
+    int a[] = {3, 1, 3, 2, 1};
+
+    auto end = sorter.sort_unique(a, a + 5, LESS(int));
+
+    EXPECT_EQ(end, a + 3);
+    EXPECT_EQ(a[0], 1);
+    EXPECT_EQ(a[1], 2);
+    EXPECT_EQ(a[2], 3);
+}
+
+// The test checks that the large array with many equal elements
+// gives the same unique elements as std::sort and std::unique.
+TEST(UniqueSorterTest, LargeArray_SORT_UNIQUE) {
+    for (auto range : {1u, 7u, 500u, 100000u}) {
+        std::vector<std::string> a(5000);
+        for (auto &elem : a) elem = std::to_string(mersenne() % range);
+        auto expected = a;
+        std::sort(expected.begin(), expected.end(), GREATER(std::string));
+        expected.erase(std::unique(expected.begin(), expected.end()),
+                       expected.end());
+
+        auto end = sorter.sort_unique(a.data(), a.data() + a.size(),
+                                      GREATER(std::string));
+
+        a.resize(end - a.data());
+        EXPECT_EQ(a, expected);
+    }
+}
+
+// The test checks the processing of an empty and a single-element array.
+TEST(UniqueSorterTest, EmptyAndOneElement_SORT_UNIQUE) {
+    int a[] {4};
+
+    EXPECT_EQ(sorter.sort_unique(a, a, LESS(int)), a);
+    EXPECT_EQ(sorter.sort_unique(a, a + 1, LESS(int)), a + 1);
+    EXPECT_EQ(a[0], 4);
+}
+
+// The test checks the example from the description of the function.
+TEST(UniqueSorterTest, SmallArray_SORT_REDUCE_BY_KEY) {
+    int keys[] = {2, 1, 2};
+    int counts[] = {1, 1, 1};
+
+    auto end = sorter.sort_reduce_by_key(keys, keys + 3, counts, LESS(int),
+                                         [](int a, int b) {return a + b;});
+
+    EXPECT_EQ(end, keys + 2);
+    EXPECT_EQ(keys[0], 1);
+    EXPECT_EQ(keys[1], 2);
+    EXPECT_EQ(counts[0], 1);
+    EXPECT_EQ(counts[1], 2);
+}
+
+// The test checks that the sums of values by keys of the large array
+// are equal to the sums counted directly.
+TEST(UniqueSorterTest, LargeArray_SORT_REDUCE_BY_KEY) {
+    const auto size = 20000, range = 300;
+    std::vector<int> keys(size);
+    std::vector<long> values(size), expected(range, 0);
+    for (auto i = 0; i < size; i++) {
+        keys[i] = static_cast<int>(mersenne() % range);
+        values[i] = static_cast<long>(mersenne() % 1000);
+        expected[keys[i]] += values[i];
+    }
+
+    auto end = sorter.sort_reduce_by_key(keys.data(), keys.data() + size,
+                                         values.data(), LESS(int),
+                                         [](long a, long b) {return a + b;});
+
+    EXPECT_EQ(end - keys.data(), range);
+    for (auto i = 0; i < range; i++) {
+        EXPECT_EQ(keys[i], i);
+        EXPECT_EQ(values[i], expected[i]);
+    }
+}
+
+// The test checks that no unique elements are reported
+// if the predicate or the reduce function throws.
+TEST(UniqueSorterTest, ThrowingFunctions_SORT_UNIQUE) {
+    std::vector<std::string> a(1000), keys(1000);
+    std::vector<int> values(1000, 1);
+    for (auto &elem : a) elem = std::to_string(mersenne() % 100);
+    for (auto &elem : keys) elem = std::to_string(mersenne() % 100);
+    auto calls = 0;
+
+    ::testing::internal::CaptureStderr();
+    auto end = sorter.sort_unique(a.data(), a.data() + a.size(),
+                                  [&calls](const std::string &x, const std::string &y) {
+        if (++calls == 3000) throw std::runtime_error("comparison");
+        return x < y;
+    });
+    auto keys_end = sorter.sort_reduce_by_key(keys.data(), keys.data() + keys.size(),
+                                              values.data(), LESS(std::string),
+                                              [](int, int) -> int {
+        throw std::runtime_error("reduce");
+    });
+    std::string error_message = ::testing::internal::GetCapturedStderr();
+
+    EXPECT_EQ(end, a.data());
+    EXPECT_EQ(keys_end, keys.data());
+    EXPECT_NE(error_message.find("comparison"), std::string::npos);
+    EXPECT_NE(error_message.find("reduce"), std::string::npos);
+}
+
+/*
+ * Tests on sorting with expensive predicates
+ */
+
+// The test checks that binary inserts sort the short intervals
+// with fewer calls of the predicate.
+TEST(BinaryInsertionSorterTest, FewerComparisons_SORT) {
+    const auto size = const_sort::binary_insert_len;
+    std::vector<int> linear(size);
+    for (auto &elem : linear) elem = static_cast<int>(mersenne() % 1000);
+    auto binary = linear;
+    long linear_calls = 0, binary_calls = 0;
+    Sorter linear_sorter(const_sort::binary_insert_len, false),
+            binary_sorter(const_sort::insert_len, false);
+    binary_sorter.set_comparator_cost(ComparatorCost::expensive);
+
+    linear_sorter.sort(linear.data(), linear.data() + size,
+                       [&](int a, int b) {linear_calls++; return a < b;});
+    binary_sorter.sort(binary.data(), binary.data() + size,
+                       [&](int a, int b) {binary_calls++; return a < b;});
+
+    EXPECT_TRUE(std::is_sorted(binary.begin(), binary.end()));
+    EXPECT_EQ(binary, linear);
+    EXPECT_LT(binary_calls, linear_calls);
+}
+
+// The test checks that the large array of strings is sorted correctly
+// with binary inserts in the leaves.
+TEST(BinaryInsertionSorterTest, LargeArray_SORT) {
+    std::vector<std::string> a(3000);
+    for (auto &elem : a) elem = std::to_string(mersenne() % 500);
+    auto expected = a;
+    std::sort(expected.begin(), expected.end(), GREATER(std::string));
+    Sorter binary_sorter;
+    binary_sorter.set_comparator_cost(ComparatorCost::expensive);
+
+    binary_sorter.sort(a.data(), a.data() + a.size(), GREATER(std::string));
+
+    EXPECT_EQ(a, expected);
+}
+
+// The test checks that the predicate whose every call takes a tick
+// is calibrated as expensive and the array is sorted with the chosen leaves.
+TEST(BinaryInsertionSorterTest, SlowPredicate_CALIBRATE) {
+    std::vector<int> a(256);
+    for (auto &elem : a) elem = mersenne();
+    Sorter calibrated_sorter;
+
+    auto slow = calibrated_sorter.calibrate<TickClock>(
+            a.data(), a.data() + a.size(), [](int a, int b) {
+        TickClock::ticks++;
+        return a < b;
+    });
+
+    EXPECT_EQ(slow, ComparatorCost::expensive);
+    calibrated_sorter.sort(a.data(), a.data() + a.size(), LESS(int));
+    EXPECT_TRUE(std::is_sorted(a.begin(), a.end()));
+}
+
+// The test checks that the predicate which takes no ticks
+// is calibrated as cheap and the sample is not changed.
+TEST(BinaryInsertionSorterTest, FastPredicate_CALIBRATE) {
+    std::vector<int> a(const_sort::calibration_len);
+    for (auto &elem : a) elem = mersenne();
+    auto expected = a;
+    Sorter calibrated_sorter;
+
+    auto fast = calibrated_sorter.calibrate<TickClock>(
+            a.data(), a.data() + a.size(), LESS(int));
+
+    EXPECT_EQ(fast, ComparatorCost::cheap);
+    EXPECT_EQ(a, expected);
+}
+
+/*
+ * Tests on counting the work of the sorting
+ */
+
+// The test checks that the counters agree with the calls of the predicate
+// and the array is sorted as without counters.
+TEST(StatsSorterTest, RandomArray_SORT) {
+    const auto size = 10000;
+    std::vector<int> a(size);
+    for (auto &elem : a) elem = static_cast<int>(mersenne() % 100000);
+    auto expected = a;
+    long calls = 0;
+    Sorter stats_sorter(const_sort::insert_len, false);
+
+    auto stats = stats_sorter.sort<SortStats>(a.data(), a.data() + size,
+            [&](int a, int b) {calls++; return a < b;});
+    stats_sorter.sort(expected.data(), expected.data() + size, LESS(int));
+
+    EXPECT_EQ(a, expected);
+    EXPECT_EQ(stats.elements, size);
+    EXPECT_EQ(stats.comparisons, calls);
+    EXPECT_GT(stats.moves, 0);
+    EXPECT_GT(stats.max_depth, 0);
+    EXPECT_LT(stats.max_depth, 100);
+    EXPECT_LT(stats.unbalanced_partitions, size / 10);
+    EXPECT_DOUBLE_EQ(stats.insertion_share(), 1);
+    static_assert(std::is_empty_v<decltype(sorter.sort(a.data(), a.data(), LESS(int)))>);
+}
+
+// The test checks that the input with the quadratic time
+// (the median of three is the second smallest element of every interval)
+// is found by the depth and the unbalanced partitions.
+TEST(StatsSorterTest, OrganPipe_SORT) {
+    const auto size = 2000;
+    std::vector<int> a(size);
+    for (auto i = 0; i < size; i++) a[i] = (i < size / 2) ? i : size - i;
+    Sorter stats_sorter(const_sort::insert_len, false);
+
+    auto stats = stats_sorter.sort<SortStats>(a.data(), a.data() + size, LESS(int));
+
+    EXPECT_TRUE(std::is_sorted(a.begin(), a.end()));
+    EXPECT_GT(stats.max_depth, size / 4);
+    EXPECT_GT(stats.unbalanced_partitions, size / 4);
+    EXPECT_GT(stats.comparisons, static_cast<long>(size) * size / 8);
+}
+
+// The test checks the counters of the reversed array
+// that is sorted by the search of runs without quicksort.
+TEST(StatsSorterTest, ReversedArray_SORT) {
+    const auto size = 1001;
+    std::vector<int> a(size);
+    for (auto i = 0; i < size; i++) a[i] = size - i;
+
+    auto stats = sorter.sort<SortStats>(a.data(), a.data() + size, LESS(int));
+
+    EXPECT_TRUE(std::is_sorted(a.begin(), a.end()));
+    EXPECT_EQ(stats.moves, 3 * (size / 2));
+    EXPECT_EQ(stats.max_depth, 0);
+    EXPECT_DOUBLE_EQ(stats.insertion_share(), 0);
+}
+
+/*
+ * Tests on measuring the time
+ */
+
+// The test checks the median, the median absolute deviation
+// and the confidence interval of the known times.
+TEST(TimeMeterTest, KnownTimes_STATISTICS) {
+    auto stats = TimeMeter::statistics({5, 1, 4, 2, 3, 100});
+
+    EXPECT_DOUBLE_EQ(stats.median, 3.5);
+    EXPECT_DOUBLE_EQ(stats.mad, 1.5);
+    EXPECT_EQ(stats.repetitions, 6);
+    EXPECT_LE(stats.confidence_low, stats.median);
+    EXPECT_GE(stats.confidence_high, stats.median);
+    EXPECT_TRUE(stats.noisy);
+    EXPECT_TRUE(stats.is_disturbed());
+}
+
+// The test checks that the data is prepared before every repetition
+// including the warm-up ones, and only the measured ones are counted.
+TEST(TimeMeterTest, WarmupAndRepetitions_MEASURE) {
+    TimeMeter time_meter(7, 1, 2, -1);
+    auto prepared = 0, runs = 0;
+
+    auto stats = time_meter.measure([&]() {prepared++;}, [&]() {runs++;});
+
+    EXPECT_EQ(prepared, 9);
+    EXPECT_EQ(runs, 9);
+    EXPECT_EQ(stats.repetitions, 7);
+    EXPECT_GE(stats.median, 0.0);
+}
+
+// The test checks the limits of the number of experiments.
+TEST(TimeMeterTest, ExperimentCount_EXCEPTION) {
+    EXPECT_THROW(TimeMeter(0), std::invalid_argument);
+    EXPECT_THROW(TimeMeter(const_time_meter::experiment_count_limit + 1),
+                 std::invalid_argument);
+}
+
+// The test checks that the found length of the interval
+// for insertion sorting is in the allowed limits
+// (one measured repetition without warm-up to keep the test short).
+TEST(TimeMeterTest, OptimalLength_EXPERIMENT_WITH_ARRAY_COUNT) {
+    TimeMeter time_meter(1, const_time_meter::seed_default, 0, -1);
+
+    ::testing::internal::CaptureStdout();
+    auto length = time_meter.experiment_with_array_count();
+    ::testing::internal::GetCapturedStdout();
+
+    EXPECT_GE(length, 1);
+    EXPECT_LE(length, const_time_meter::length_limit);
+}